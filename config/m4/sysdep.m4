@@ -268,6 +268,8 @@ AC_CHECK_HEADERS([endian.h, sys/endian.h])
 AC_CHECK_HEADERS([linux/mman.h])
 AC_CHECK_HEADERS([linux/ip.h])
 AC_CHECK_HEADERS([linux/futex.h])
+AC_CHECK_HEADERS([linux/userfaultfd.h])
+AC_CHECK_HEADERS([linux/mempolicy.h])
 
 
 #
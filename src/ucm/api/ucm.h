@@ -219,6 +219,8 @@ typedef struct ucm_global_config {
     int                  dlopen_process_rpath;        /* Process RPATH section in dlopen hook */
     int                  module_unload_prevent_mode;  /* Module unload prevention mode */
     int                  bistro_force_far_jump;       /* Force far jump with bistro pathcing */
+    size_t               malloc_hugepage_thresh;      /* Minimal size of allocations
+                                                         backed by huge pages */
 } ucm_global_config_t;
 
 
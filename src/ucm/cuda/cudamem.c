@@ -30,9 +30,10 @@
                         UCM_FUNC_DEFINE_ARGS(__VA_ARGS__)) \
     { \
         _ptr_type ptr; \
+        unsigned epoch; \
         _retval ret; \
         \
-        ucm_event_enter(); \
+        epoch = ucm_event_enter(); \
         ret = ucm_orig_##_name(ptr_arg, UCM_FUNC_PASS_ARGS(__VA_ARGS__)); \
         if (ret == (_success)) { \
             ptr = _ref ptr_arg; \
@@ -41,7 +42,7 @@
             ucm_cuda_dispatch_mem_alloc((CUdeviceptr)ptr, (_size), \
                                         (_mem_type)); \
         } \
-        ucm_event_leave(); \
+        ucm_event_leave(epoch); \
         return ret; \
     }
 
@@ -50,15 +51,16 @@
                            _args_fmt, ...) \
     _retval ucm_##_name(UCM_FUNC_DEFINE_ARGS(__VA_ARGS__)) \
     { \
+        unsigned epoch; \
         _retval ret; \
         \
-        ucm_event_enter(); \
+        epoch = ucm_event_enter(); \
         ucm_trace("%s(" _args_fmt ")", __FUNCTION__, \
                   UCM_FUNC_PASS_ARGS(__VA_ARGS__)); \
         ucm_cuda_dispatch_mem_free((CUdeviceptr)(_ptr_arg), _size, _mem_type, \
                                    #_name); \
         ret = ucm_orig_##_name(UCM_FUNC_PASS_ARGS(__VA_ARGS__)); \
-        ucm_event_leave(); \
+        ucm_event_leave(epoch); \
         return ret; \
     }
 
@@ -380,6 +382,7 @@ static int ucm_cudamem_scan_regions_cb(void *arg, void *addr, size_t length,
     static const char *cuda_path_pattern = "/dev/nvidia";
     ucm_event_handler_t *handler         = arg;
     ucm_event_t event;
+    unsigned epoch;
 
     /* we are interested in blocks which don't have any access permissions, or
      * mapped to nvidia device.
@@ -396,9 +399,9 @@ static int ucm_cudamem_scan_regions_cb(void *arg, void *addr, size_t length,
     event.mem_type.size     = length;
     event.mem_type.mem_type = UCS_MEMORY_TYPE_LAST; /* unknown memory type */
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
     handler->cb(UCM_EVENT_MEM_TYPE_ALLOC, &event, handler->arg);
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return 0;
 }
@@ -13,15 +13,19 @@
 #include <ucm/mmap/mmap.h>
 #include <ucm/malloc/malloc_hook.h>
 #include <ucm/util/sys.h>
+#include <ucs/arch/atomic.h>
+#include <ucs/arch/bitops.h>
 #include <ucs/arch/cpu.h>
 #include <ucs/datastruct/khash.h>
 #include <ucs/sys/compiler.h>
 #include <ucs/sys/module.h>
+#include <ucs/sys/ptr_arith.h>
 #include <ucs/type/init_once.h>
 #include <ucs/type/spinlock.h>
 
 #include <sys/mman.h>
 #include <pthread.h>
+#include <sched.h>
 #include <sys/shm.h>
 #include <sys/ipc.h>
 #include <stdlib.h>
@@ -30,13 +34,51 @@
 #include <inttypes.h>
 
 
+/* Number of event types, each one is a bit in the events mask */
+#define UCM_EVENT_TYPE_COUNT        32
+
+/* Number of reader counters, log2. Threads are spread over the counters to
+ * avoid contention on a single cache line. */
+#define UCM_EVENT_READER_SLOTS_LOG  6
+
+
+/* Handler entry in an event handlers snapshot */
+typedef struct {
+    ucm_event_callback_t cb;
+    void                 *arg;
+} ucm_event_entry_t;
+
+
+/*
+ * Immutable copy of the handlers list, with a separate array of handlers for
+ * every event type, ordered by priority and terminated by a NULL callback.
+ * A new snapshot is published for every change of the handlers list, and the
+ * old one is released after all dispatches which could use it are done.
+ */
+typedef struct {
+    size_t            size;
+    ucm_event_entry_t *handlers[UCM_EVENT_TYPE_COUNT];
+    ucm_event_entry_t entries[0];
+} ucm_event_snapshot_t;
+
+
+/* Counters of threads inside event dispatch, for each of the two epochs */
+typedef struct {
+    volatile uint64_t readers[2];
+} UCS_V_ALIGNED(UCS_SYS_CACHE_LINE_SIZE) ucm_event_reader_slot_t;
+
+
 UCS_LIST_HEAD(ucm_event_installer_list);
 
 static pthread_spinlock_t ucm_kh_lock;
 #define ucm_ptr_hash(_ptr)  kh_int64_hash_func((uintptr_t)(_ptr))
 KHASH_INIT(ucm_ptr_size, const void*, size_t, 1, ucm_ptr_hash, kh_int64_hash_equal)
 
-static pthread_rwlock_t ucm_event_lock       = PTHREAD_RWLOCK_INITIALIZER;
+static pthread_mutex_t ucm_event_update_lock = PTHREAD_MUTEX_INITIALIZER;
+static ucm_event_snapshot_t *volatile ucm_event_snapshot = NULL;
+static volatile uint32_t ucm_event_epoch     = 0;
+static ucm_event_reader_slot_t
+ucm_event_reader_slots[UCS_BIT(UCM_EVENT_READER_SLOTS_LOG)];
 static ucs_init_once_t ucm_library_init_once = UCS_INIT_ONCE_INITIALIZER;
 static ucs_list_link_t ucm_event_handlers;
 static int ucm_external_events = 0;
@@ -138,50 +180,130 @@ static ucs_list_link_t ucm_event_handlers =
 
 void ucm_event_dispatch(ucm_event_type_t event_type, ucm_event_t *event)
 {
-    ucm_event_handler_t *handler;
+    const ucm_event_snapshot_t *snapshot = ucm_event_snapshot;
+    const ucm_event_entry_t *entry;
 
-    ucs_list_for_each(handler, &ucm_event_handlers, list) {
-        if (handler->events & event_type) {
-            handler->cb(event_type, event, handler->arg);
+    if (ucs_unlikely(snapshot == NULL)) {
+        /* No handlers were added yet */
+        if (event_type & ucm_event_orig_handler.events) {
+            ucm_event_call_orig(event_type, event, NULL);
         }
+        return;
     }
-}
 
-#define ucm_event_lock(_lock_func) \
-    { \
-        int ret; \
-        do { \
-            ret = _lock_func(&ucm_event_lock); \
-        } while (ret == EAGAIN); \
-        if (ret != 0) { \
-            ucm_fatal("%s() failed: %s", #_lock_func, strerror(ret)); \
-        } \
+    for (entry = snapshot->handlers[ucs_ilog2(event_type)]; entry->cb != NULL;
+         ++entry) {
+        entry->cb(event_type, event, entry->arg);
     }
+}
 
-void ucm_event_enter()
+static UCS_F_ALWAYS_INLINE ucm_event_reader_slot_t *ucm_event_reader_slot()
 {
-    ucm_event_lock(pthread_rwlock_rdlock);
+    uint64_t hash = (uint64_t)pthread_self() * 0x9e3779b97f4a7c15ul;
+
+    return &ucm_event_reader_slots[hash >> (64 - UCM_EVENT_READER_SLOTS_LOG)];
 }
 
-void ucm_event_enter_exclusive()
+unsigned ucm_event_enter()
 {
-    ucm_event_lock(pthread_rwlock_wrlock);
+    unsigned epoch = ucm_event_epoch & 1;
+
+    ucs_atomic_add64(&ucm_event_reader_slot()->readers[epoch], 1);
+    /* Load the snapshot only after announcing the reader */
+    ucs_memory_cpu_fence();
+    return epoch;
 }
 
-void ucm_event_leave()
+void ucm_event_leave(unsigned epoch)
 {
-    pthread_rwlock_unlock(&ucm_event_lock);
+    ucs_memory_cpu_fence();
+    ucs_atomic_sub64(&ucm_event_reader_slot()->readers[epoch], 1);
+}
+
+/*
+ * Wait until all threads which could have loaded the previous snapshot have
+ * left event dispatch. Flipping the epoch twice ensures that readers which
+ * loaded the epoch before the first flip and announced themselves after it
+ * are waited for as well.
+ */
+static void ucm_event_synchronize()
+{
+    unsigned i, flip, epoch;
+
+    for (flip = 0; flip < 2; ++flip) {
+        epoch = ucs_atomic_fadd32(&ucm_event_epoch, 1) & 1;
+        ucs_memory_cpu_fence();
+        for (i = 0; i < ucs_static_array_size(ucm_event_reader_slots); ++i) {
+            while (ucm_event_reader_slots[i].readers[epoch] != 0) {
+                sched_yield();
+            }
+        }
+    }
+}
+
+/* Called with ucm_event_update_lock held */
+static void ucm_event_snapshot_update()
+{
+    ucm_event_snapshot_t *snapshot, *old_snapshot;
+    ucm_event_handler_t *handler;
+    ucm_event_entry_t *entry;
+    size_t num_entries, size;
+    unsigned event_index;
+
+    /* Reserve one terminating entry for every event type */
+    num_entries = UCM_EVENT_TYPE_COUNT;
+    ucs_list_for_each(handler, &ucm_event_handlers, list) {
+        num_entries += ucs_popcount(handler->events);
+    }
+
+    /* Do not use malloc, since it could be called from malloc hooks */
+    size     = ucs_align_up_pow2(sizeof(*snapshot) +
+                                 (num_entries * sizeof(*entry)),
+                                 ucm_get_page_size());
+    snapshot = ucm_orig_mmap(NULL, size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (snapshot == MAP_FAILED) {
+        ucm_fatal("failed to allocate event handlers snapshot (size=%zu): %m",
+                  size);
+    }
+
+    snapshot->size = size;
+    entry          = snapshot->entries;
+    for (event_index = 0; event_index < UCM_EVENT_TYPE_COUNT; ++event_index) {
+        snapshot->handlers[event_index] = entry;
+        ucs_list_for_each(handler, &ucm_event_handlers, list) {
+            if (handler->events & UCS_BIT(event_index)) {
+                entry->cb  = handler->cb;
+                entry->arg = handler->arg;
+                ++entry;
+            }
+        }
+        entry->cb  = NULL;
+        entry->arg = NULL;
+        ++entry;
+    }
+
+    old_snapshot = ucm_event_snapshot;
+    ucs_memory_cpu_store_fence();
+    ucm_event_snapshot = snapshot;
+
+    ucm_event_synchronize();
+
+    if (old_snapshot != NULL) {
+        ucm_orig_munmap(old_snapshot, old_snapshot->size);
+    }
 }
 
 UCS_F_NOINLINE
 void *ucm_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t offset)
 {
     ucm_event_t event;
+    unsigned epoch;
 
     ucm_trace("ucm_mmap(addr=%p length=%lu prot=0x%x flags=0x%x fd=%d offset=%ld)",
               addr, length, prot, flags, fd, (long)offset);
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     if ((flags & MAP_FIXED) && (addr != NULL)) {
         ucm_dispatch_vm_munmap(addr, length);
@@ -201,7 +323,7 @@ void *ucm_mmap(void *addr, size_t length, int prot, int flags, int fd, off_t off
         ucm_dispatch_vm_mmap(event.mmap.result, length);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.mmap.result;
 }
@@ -210,8 +332,9 @@ UCS_F_NOINLINE
 int ucm_munmap(void *addr, size_t length)
 {
     ucm_event_t event;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_munmap(addr=%p length=%lu)", addr, length);
 
@@ -222,29 +345,33 @@ int ucm_munmap(void *addr, size_t length)
     event.munmap.size    = length;
     ucm_event_dispatch(UCM_EVENT_MUNMAP, &event);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.munmap.result;
 }
 
 void ucm_vm_mmap(void *addr, size_t length)
 {
-    ucm_event_enter();
+    unsigned epoch;
+
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_vm_mmap(addr=%p length=%lu)", addr, length);
     ucm_dispatch_vm_mmap(addr, length);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 }
 
 void ucm_vm_munmap(void *addr, size_t length)
 {
-    ucm_event_enter();
+    unsigned epoch;
+
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_vm_munmap(addr=%p length=%lu)", addr, length);
     ucm_dispatch_vm_munmap(addr, length);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 }
 
 UCS_F_NOINLINE
@@ -253,8 +380,9 @@ ucm_mremap(void *old_address, size_t old_size, size_t new_size, int flags, ...)
 {
     ucm_event_t event;
     va_list ap;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_mremap(old_address=%p old_size=%lu new_size=%ld flags=0x%x)",
               old_address, old_size, new_size, flags);
@@ -281,7 +409,7 @@ ucm_mremap(void *old_address, size_t old_size, size_t new_size, int flags, ...)
         ucm_dispatch_vm_mmap(event.mremap.result, new_size);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.mremap.result;
 }
@@ -315,8 +443,9 @@ void *ucm_shmat(int shmid, const void *shmaddr, int shmflg)
     khiter_t iter;
     size_t size;
     int result;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_shmat(shmid=%d shmaddr=%p shmflg=0x%x)",
               shmid, shmaddr, shmflg);
@@ -350,7 +479,7 @@ void *ucm_shmat(int shmid, const void *shmaddr, int shmflg)
         ucm_dispatch_vm_mmap(event.shmat.result, size);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.shmat.result;
 }
@@ -360,8 +489,9 @@ int ucm_shmdt(const void *shmaddr)
 {
     ucm_event_t event;
     size_t size;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_shmdt(shmaddr=%p)", shmaddr);
 
@@ -375,7 +505,7 @@ int ucm_shmdt(const void *shmaddr)
     event.shmdt.shmaddr = shmaddr;
     ucm_event_dispatch(UCM_EVENT_SHMDT, &event);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.shmdt.result;
 }
@@ -384,8 +514,9 @@ UCS_F_NOINLINE
 void *ucm_sbrk(intptr_t increment)
 {
     ucm_event_t event;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_sbrk(increment=%+ld)", increment);
 
@@ -405,7 +536,7 @@ void *ucm_sbrk(intptr_t increment)
                              increment);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.sbrk.result;
 }
@@ -416,8 +547,9 @@ int ucm_brk(void *addr)
     ptrdiff_t increment;
     void *current_brk;
     ucm_event_t event;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_brk(addr=%p)", addr);
 
@@ -440,7 +572,7 @@ int ucm_brk(void *addr)
         ucm_dispatch_vm_mmap(current_brk, increment);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.brk.result;
 }
@@ -449,8 +581,9 @@ UCS_F_NOINLINE
 int ucm_madvise(void *addr, size_t length, int advice)
 {
     ucm_event_t event;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_madvise(addr=%p length=%zu advice=%d)", addr, length, advice);
 
@@ -475,7 +608,7 @@ int ucm_madvise(void *addr, size_t length, int advice)
     event.madvise.advice = advice;
     ucm_event_dispatch(UCM_EVENT_MADVISE, &event);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return event.madvise.result;
 }
@@ -499,24 +632,26 @@ void ucm_event_handler_add(ucm_event_handler_t *handler)
 {
     ucm_event_handler_t *elem;
 
-    ucm_event_enter_exclusive();
+    pthread_mutex_lock(&ucm_event_update_lock);
     ucs_list_for_each(elem, &ucm_event_handlers, list) {
         if (handler->priority < elem->priority) {
             ucs_list_insert_before(&elem->list, &handler->list);
-            ucm_event_leave();
-            return;
+            goto out;
         }
     }
 
     ucs_list_add_tail(&ucm_event_handlers, &handler->list);
-    ucm_event_leave();
+out:
+    ucm_event_snapshot_update();
+    pthread_mutex_unlock(&ucm_event_update_lock);
 }
 
 void ucm_event_handler_remove(ucm_event_handler_t *handler)
 {
-    ucm_event_enter_exclusive();
+    pthread_mutex_lock(&ucm_event_update_lock);
     ucs_list_del(&handler->list);
-    ucm_event_leave();
+    ucm_event_snapshot_update();
+    pthread_mutex_unlock(&ucm_event_update_lock);
 }
 
 static ucs_status_t ucm_event_install(int events)
@@ -624,18 +759,18 @@ ucs_status_t ucm_set_event_handler(int events, int priority,
 
 void ucm_set_external_event(int events)
 {
-    ucm_event_enter_exclusive();
+    pthread_mutex_lock(&ucm_event_update_lock);
     ucm_debug("set external events: 0x%x", events);
     ucm_external_events |= events;
-    ucm_event_leave();
+    pthread_mutex_unlock(&ucm_event_update_lock);
 }
 
 void ucm_unset_external_event(int events)
 {
-    ucm_event_enter_exclusive();
+    pthread_mutex_lock(&ucm_event_update_lock);
     ucm_debug("unset external events: 0x%x", events);
     ucm_external_events &= ~events;
-    ucm_event_leave();
+    pthread_mutex_unlock(&ucm_event_update_lock);
 }
 
 void ucm_unset_event_handler(int events, ucm_event_callback_t cb, void *arg)
@@ -643,7 +778,7 @@ void ucm_unset_event_handler(int events, ucm_event_callback_t cb, void *arg)
     ucm_event_handler_t *elem, *tmp;
     UCS_LIST_HEAD(gc_list);
 
-    ucm_event_enter_exclusive();
+    pthread_mutex_lock(&ucm_event_update_lock);
     ucs_list_for_each_safe(elem, tmp, &ucm_event_handlers, list) {
         if ((cb == elem->cb) && (arg == elem->arg)) {
             elem->events &= ~events;
@@ -653,7 +788,10 @@ void ucm_unset_event_handler(int events, ucm_event_callback_t cb, void *arg)
             }
         }
     }
-    ucm_event_leave();
+
+    /* After this call returns, the callback is not called anymore */
+    ucm_event_snapshot_update();
+    pthread_mutex_unlock(&ucm_event_update_lock);
 
     /* Do not release memory while we hold event lock - may deadlock */
     ucs_list_for_each_safe(elem, tmp, &gc_list, list) {
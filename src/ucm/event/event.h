@@ -47,11 +47,10 @@ void ucm_event_handler_remove(ucm_event_handler_t *handler);
 
 void ucm_event_dispatch(ucm_event_type_t event_type, ucm_event_t *event);
 
-void ucm_event_enter();
+/* Enter event dispatch section, returns the epoch to pass to ucm_event_leave */
+unsigned ucm_event_enter();
 
-void ucm_event_enter_exclusive();
-
-void ucm_event_leave();
+void ucm_event_leave(unsigned epoch);
 
 static UCS_F_ALWAYS_INLINE void
 ucm_dispatch_vm_mmap(void *addr, size_t length)
@@ -252,6 +252,7 @@ static void *ucm_malloc_impl(size_t size, const char *debug_name)
 
 static void ucm_malloc_adjust_thresholds(size_t size)
 {
+    size_t max_thresh;
     int mmap_thresh;
 
     if (size > ucm_malloc_hook_state.max_freed_size) {
@@ -265,8 +266,10 @@ static void ucm_malloc_adjust_thresholds(size_t size)
             /* new mmap threshold is increased to the size of released block,
              * new trim threshold is twice that size.
              */
+            max_thresh  = ucs_min(UCM_DEFAULT_MMAP_THRESHOLD_MAX,
+                                  ucm_global_opts.malloc_hugepage_thresh);
             mmap_thresh = ucs_min(ucs_max(ucm_dlmallopt_get(M_MMAP_THRESHOLD), size),
-                                  UCM_DEFAULT_MMAP_THRESHOLD_MAX);
+                                  max_thresh);
             ucm_trace("adjust mmap threshold to %d", mmap_thresh);
             ucm_dlmallopt(M_MMAP_THRESHOLD, mmap_thresh);
             ucm_dlmallopt(M_TRIM_THRESHOLD, mmap_thresh * 2);
@@ -279,6 +282,44 @@ static void ucm_malloc_adjust_thresholds(size_t size)
     }
 }
 
+/* Called by ptmalloc to map a chunk which exceeds the mmap threshold */
+void *ucm_malloc_direct_mmap(size_t size)
+{
+    size_t huge_page_size = ucm_get_huge_page_size();
+    size_t head;
+    void *ptr;
+
+    if ((size < ucm_global_opts.malloc_hugepage_thresh) ||
+        (huge_page_size == 0)) {
+        return mmap(NULL, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    /* Map one extra huge page, and trim the mapping to start at a huge page
+     * boundary, so the kernel can back it by huge pages from the beginning */
+    ptr = mmap(NULL, size + huge_page_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return MAP_FAILED;
+    }
+
+    head = ucs_padding((uintptr_t)ptr, huge_page_size);
+    if (head > 0) {
+        munmap(ptr, head);
+    }
+
+    ptr = UCS_PTR_BYTE_OFFSET(ptr, head);
+    if (head < huge_page_size) {
+        munmap(UCS_PTR_BYTE_OFFSET(ptr, size), huge_page_size - head);
+    }
+
+#ifdef MADV_HUGEPAGE
+    madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    ucm_trace("mapped %zu bytes at %p for huge pages", size, ptr);
+    return ptr;
+}
+
 static inline void ucm_mem_free(void *ptr, size_t size)
 {
     VALGRIND_FREELIKE_BLOCK(ptr, 0);
@@ -788,6 +829,16 @@ static void ucm_malloc_set_env_mallopt()
         ucm_debug("set mmap_thresh to %d", atoi(p));
         ucm_malloc_mallopt(M_MMAP_THRESHOLD, atoi(p));
     }
+
+    /* allocations backed by huge pages are always mapped separately */
+    if (!ucm_malloc_hook_state.mmap_thresh_set &&
+        (ucm_global_opts.malloc_hugepage_thresh <
+         (size_t)ucm_dlmallopt_get(M_MMAP_THRESHOLD))) {
+        ucm_debug("set mmap_thresh to hugepage thresh %zu",
+                  ucm_global_opts.malloc_hugepage_thresh);
+        ucm_dlmallopt(M_MMAP_THRESHOLD,
+                      ucm_global_opts.malloc_hugepage_thresh);
+    }
 }
 
 static void ucm_malloc_init_orig_funcs()
@@ -591,6 +591,10 @@ MAX_RELEASE_CHECK_RATE   default: 4095 unless not HAVE_MMAP
 /* The maximum possible size_t value has all bits set */
 #define MAX_SIZE_T           (~(size_t)0)
 
+/* Large chunks are mapped by UCM, which may back them by huge pages */
+void *ucm_malloc_direct_mmap(size_t size);
+#define DIRECT_MMAP(s) ucm_malloc_direct_mmap(s)
+
 #ifndef USE_LOCKS /* ensure true if spin or recursive locks set */
 #define USE_LOCKS  ((defined(USE_SPIN_LOCKS) && USE_SPIN_LOCKS != 0) || \
                     (defined(USE_RECURSIVE_LOCKS) && USE_RECURSIVE_LOCKS != 0))
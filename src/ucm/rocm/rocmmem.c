@@ -94,8 +94,9 @@ static void ucm_hsa_amd_memory_pool_free_dispatch_events(void *ptr)
 hsa_status_t ucm_hsa_amd_memory_pool_free(void* ptr)
 {
     hsa_status_t status;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_hsa_amd_memory_pool_free(ptr=%p)", ptr);
 
@@ -103,7 +104,7 @@ hsa_status_t ucm_hsa_amd_memory_pool_free(void* ptr)
 
     status = ucm_orig_hsa_amd_memory_pool_free(ptr);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
     return status;
 }
 
@@ -112,8 +113,9 @@ hsa_status_t ucm_hsa_amd_memory_pool_allocate(
     uint32_t flags, void** ptr)
 {
     hsa_status_t status;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     status = ucm_orig_hsa_amd_memory_pool_allocate(memory_pool, size, flags, ptr);
     if (status == HSA_STATUS_SUCCESS) {
@@ -121,7 +123,7 @@ hsa_status_t ucm_hsa_amd_memory_pool_allocate(
         ucm_dispatch_mem_type_alloc(*ptr, size, UCS_MEMORY_TYPE_UNKNOWN);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
     return status;
 }
 
@@ -175,6 +177,7 @@ static int ucm_rocm_scan_regions_cb(void *arg, void *addr, size_t length,
     static const char *rocm_path_pattern = "/dev/dri";
     ucm_event_handler_t *handler = arg;
     ucm_event_t event;
+    unsigned epoch;
 
     if ((prot & (PROT_READ | PROT_WRITE | PROT_EXEC)) &&
         strncmp(path, rocm_path_pattern, strlen(rocm_path_pattern))) {
@@ -187,9 +190,9 @@ static int ucm_rocm_scan_regions_cb(void *arg, void *addr, size_t length,
     event.mem_type.size     = length;
     event.mem_type.mem_type = UCS_MEMORY_TYPE_LAST; /* unknown memory type */
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
     handler->cb(UCM_EVENT_MEM_TYPE_ALLOC, &event, handler->arg);
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return 0;
 }
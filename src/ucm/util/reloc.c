@@ -58,6 +58,13 @@ typedef struct ucm_reloc_dl_iter_context {
 } ucm_reloc_dl_iter_context_t;
 
 
+typedef struct ucm_reloc_dlopen_iter_context {
+    ucs_status_t       status;
+    int                first;      /* Whether this is the first object */
+    unsigned long long adds, subs; /* Loaded/unloaded objects counters */
+} ucm_reloc_dlopen_iter_context_t;
+
+
 /* Hash of symbols in a dynamic object */
 KHASH_MAP_INIT_STR(ucm_dl_symbol_hash, void*);
 
@@ -65,6 +72,8 @@ KHASH_MAP_INIT_STR(ucm_dl_symbol_hash, void*);
 typedef struct {
     khash_t(ucm_dl_symbol_hash) symbols;
     uintptr_t                   start, end;
+    unsigned                    num_patches; /* How many patches from the patch
+                                                list were applied from dlopen */
 } ucm_dl_info_t;
 
 KHASH_MAP_INIT_INT64(ucm_dl_info_hash, ucm_dl_info_t)
@@ -72,6 +81,12 @@ KHASH_MAP_INIT_INT64(ucm_dl_info_hash, ucm_dl_info_t)
 /* List of patches to be applied to additional libraries */
 static UCS_LIST_HEAD(ucm_reloc_patch_list);
 static pthread_mutex_t ucm_reloc_patch_list_lock = PTHREAD_MUTEX_INITIALIZER;
+static unsigned ucm_reloc_num_patches             = 0;
+
+/* Loaded and unloaded objects counters, as reported by dl_iterate_phdr(), when
+ * the patches were last applied from dlopen() */
+static unsigned long long ucm_reloc_dl_adds = 0;
+static unsigned long long ucm_reloc_dl_subs = 0;
 
 static khash_t(ucm_dl_info_hash) ucm_dl_info_hash      = KHASH_STATIC_INITIALIZER;
 static ucm_reloc_dlopen_func_t  ucm_reloc_orig_dlopen  = NULL;
@@ -310,7 +325,7 @@ ucm_dl_populate_symbols(ucm_dl_info_t *dl_info, uintptr_t dlpi_addr, void *table
 
 static ucs_status_t ucm_reloc_dl_info_get(const struct dl_phdr_info *phdr_info,
                                           const char *dl_name,
-                                          const ucm_dl_info_t **dl_info_p)
+                                          ucm_dl_info_t **dl_info_p)
 {
     uintptr_t dlpi_addr = phdr_info->dlpi_addr;
     unsigned UCS_V_UNUSED num_symbols;
@@ -342,8 +357,9 @@ static ucs_status_t ucm_reloc_dl_info_get(const struct dl_phdr_info *phdr_info,
     }
 
     kh_init_inplace(ucm_dl_symbol_hash, &dl_info->symbols);
-    dl_info->start = UINTPTR_MAX;
-    dl_info->end   = 0;
+    dl_info->start       = UINTPTR_MAX;
+    dl_info->end         = 0;
+    dl_info->num_patches = 0;
 
     /* Scan program headers for PT_LOAD and PT_DYNAMIC */
     dphdr         = NULL;
@@ -463,7 +479,7 @@ static int ucm_reloc_phdr_iterator(struct dl_phdr_info *phdr_info, size_t size,
                                    void *data)
 {
     ucm_reloc_dl_iter_context_t *ctx = data;
-    const ucm_dl_info_t *dl_info;
+    ucm_dl_info_t *dl_info;
     char dl_name_buffer[256];
     const char *dl_name;
     int store_prev;
@@ -517,6 +533,76 @@ static ucs_status_t ucm_reloc_apply_patch(ucm_reloc_patch_t *patch,
     return ctx.status;
 }
 
+/* called with lock held */
+static void ucm_reloc_dl_info_reset_patches()
+{
+    khiter_t khiter;
+
+    for (khiter = kh_begin(&ucm_dl_info_hash);
+         khiter != kh_end(&ucm_dl_info_hash); ++khiter) {
+        if (kh_exist(&ucm_dl_info_hash, khiter)) {
+            kh_val(&ucm_dl_info_hash, khiter).num_patches = 0;
+        }
+    }
+}
+
+static int ucm_reloc_dlopen_phdr_iterator(struct dl_phdr_info *phdr_info,
+                                          size_t size, void *data)
+{
+    ucm_reloc_dlopen_iter_context_t *ctx = data;
+    ucm_reloc_patch_t *patch;
+    ucm_dl_info_t *dl_info;
+    char dl_name_buffer[256];
+    const char *dl_name;
+
+    if (ctx->first &&
+        (size >= ucs_offsetof(struct dl_phdr_info, dlpi_subs) +
+                 sizeof(phdr_info->dlpi_subs))) {
+        ctx->adds = phdr_info->dlpi_adds;
+        ctx->subs = phdr_info->dlpi_subs;
+        if (ctx->subs != ucm_reloc_dl_subs) {
+            /* An object was unloaded, and another one could be loaded at the
+             * same address, so do not trust the applied patches counters */
+            ucm_reloc_dl_info_reset_patches();
+        } else if (ctx->adds == ucm_reloc_dl_adds) {
+            /* No new objects were loaded since last time */
+            ctx->first = 0;
+            return 1;
+        }
+    }
+    ctx->first = 0;
+
+    dl_name = ucm_reloc_get_dl_name(phdr_info->dlpi_name, phdr_info->dlpi_addr,
+                                    dl_name_buffer, sizeof(dl_name_buffer));
+
+    ctx->status = ucm_reloc_dl_info_get(phdr_info, dl_name, &dl_info);
+    if (ctx->status != UCS_OK) {
+        return -1; /* stop iteration if got a real error */
+    }
+
+    /* Skip objects which are already up-to-date, including those which do not
+     * import any of the patched symbols */
+    if (dl_info->num_patches == ucm_reloc_num_patches) {
+        return 0;
+    }
+
+    ucs_list_for_each(patch, &ucm_reloc_patch_list, list) {
+        if (ucm_reloc_patch_is_dl_blacklisted(phdr_info->dlpi_name, patch)) {
+            continue;
+        }
+
+        ctx->status = ucm_reloc_dl_apply_patch(dl_info, ucs_basename(dl_name),
+                                               phdr_info->dlpi_addr == 0,
+                                               patch);
+        if (ctx->status != UCS_OK) {
+            return -1;
+        }
+    }
+
+    dl_info->num_patches = ucm_reloc_num_patches;
+    return 0;
+}
+
 /* read serinfo from 'module_path', result buffer must be destroyed
  * by free() call */
 static Dl_serinfo *ucm_dlopen_load_serinfo(const char *module_path)
@@ -561,8 +647,8 @@ close_module:
 
 void *ucm_dlopen(const char *filename, int flag)
 {
+    ucm_reloc_dlopen_iter_context_t ctx;
     void *handle;
-    ucm_reloc_patch_t *patch;
     Dl_serinfo *serinfo;
     Dl_info dl_info;
     int res;
@@ -636,16 +722,22 @@ out_apply_patches:
      * Every time a new shared object is loaded, we must update its relocations
      * with our list of patches (including dlopen itself). We have to go over
      * the entire list of shared objects, since there more objects could be
-     * loaded due to dependencies.
+     * loaded due to dependencies. Objects which were already patched are
+     * skipped, so all patches are applied in a single pass over the objects.
      */
 
     ucm_trace("dlopen(%s) = %p", filename, handle);
 
+    ctx.status = UCS_OK;
+    ctx.first  = 1;
+    ctx.adds   = 0;
+    ctx.subs   = 0;
+
     pthread_mutex_lock(&ucm_reloc_patch_list_lock);
-    ucs_list_for_each(patch, &ucm_reloc_patch_list, list) {
-        ucm_trace("in dlopen(%s), re-applying '%s' to %p", filename,
-                  patch->symbol, patch->value);
-        ucm_reloc_apply_patch(patch, 0);
+    (void)dl_iterate_phdr(ucm_reloc_dlopen_phdr_iterator, &ctx);
+    if (ctx.status == UCS_OK) {
+        ucm_reloc_dl_adds = ctx.adds;
+        ucm_reloc_dl_subs = ctx.subs;
     }
     pthread_mutex_unlock(&ucm_reloc_patch_list_lock);
 
@@ -733,6 +825,7 @@ static ucs_status_t ucm_reloc_install_dl_hooks()
         }
 
         ucs_list_add_tail(&ucm_reloc_patch_list, &ucm_dlopen_reloc_patches[i].list);
+        ++ucm_reloc_num_patches;
     }
 
     installed = 1;
@@ -770,6 +863,7 @@ ucs_status_t ucm_reloc_modify(ucm_reloc_patch_t *patch)
     }
 
     ucs_list_add_tail(&ucm_reloc_patch_list, &patch->list);
+    ++ucm_reloc_num_patches;
 
 out_unlock:
     pthread_mutex_unlock(&ucm_reloc_patch_list_lock);
@@ -33,6 +33,7 @@
 
 
 #define UCM_PROC_SELF_MAPS "/proc/self/maps"
+#define UCM_THP_PMD_SIZE_FILE "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size"
 
 ucm_global_config_t ucm_global_opts = {
     .log_level                  = UCS_LOG_LEVEL_WARN,
@@ -49,6 +50,7 @@ ucm_global_config_t ucm_global_opts = {
     .alloc_alignment            = 16,
     .dlopen_process_rpath       = 1,
     .bistro_force_far_jump      = 0,
+    .malloc_hugepage_thresh     = SIZE_MAX,
 };
 
 size_t ucm_get_page_size()
@@ -67,6 +69,33 @@ size_t ucm_get_page_size()
     return page_size;
 }
 
+size_t ucm_get_huge_page_size()
+{
+    static ssize_t huge_page_size = -1;
+    char buf[32];
+    ssize_t nread;
+    int fd;
+
+    /* Don't use stdio, since this may be called from the malloc hook */
+    if (huge_page_size == -1) {
+        huge_page_size = 0;
+        fd             = open(UCM_THP_PMD_SIZE_FILE, O_RDONLY);
+        if (fd >= 0) {
+            nread = read(fd, buf, sizeof(buf) - 1);
+            if (nread > 0) {
+                buf[nread]     = '\0';
+                huge_page_size = strtoul(buf, NULL, 0);
+            }
+            close(fd);
+        }
+
+        if (!ucs_is_pow2_or_zero(huge_page_size)) {
+            huge_page_size = 0;
+        }
+    }
+    return huge_page_size;
+}
+
 static void *ucm_sys_complete_alloc(void *ptr, size_t size)
 {
     *(size_t*)ptr = size;
@@ -47,6 +47,12 @@ typedef int (*ucm_proc_maps_cb_t)(void *arg, void *addr, size_t length,
 size_t ucm_get_page_size();
 
 
+/**
+ * @return Size of a transparent huge page, or 0 if not supported.
+ */
+size_t ucm_get_huge_page_size();
+
+
 /**
  * Read and process entries from /proc/self/maps.
  *
@@ -106,8 +106,9 @@ ze_result_t ucm_zeMemAllocHost(ze_context_handle_t context,
                                size_t size, size_t alignment, void **ptr)
 {
     ze_result_t ret;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ret = ucm_orig_zeMemAllocHost(context, host_desc, size, alignment, ptr);
     if (ret == ZE_RESULT_SUCCESS) {
@@ -115,7 +116,7 @@ ze_result_t ucm_zeMemAllocHost(ze_context_handle_t context,
         ucm_dispatch_mem_type_alloc(*ptr, size, UCS_MEMORY_TYPE_ZE_HOST);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
     return ret;
 }
 
@@ -125,8 +126,9 @@ ze_result_t ucm_zeMemAllocDevice(ze_context_handle_t context,
                                  ze_device_handle_t device, void **ptr)
 {
     ze_result_t ret;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ret = ucm_orig_zeMemAllocDevice(context, device_desc, size, alignment,
                                     device, ptr);
@@ -135,7 +137,7 @@ ze_result_t ucm_zeMemAllocDevice(ze_context_handle_t context,
         ucm_dispatch_mem_type_alloc(*ptr, size, UCS_MEMORY_TYPE_ZE_DEVICE);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
     return ret;
 }
 
@@ -146,8 +148,9 @@ ze_result_t ucm_zeMemAllocShared(ze_context_handle_t context,
                                  ze_device_handle_t device, void **ptr)
 {
     ze_result_t ret;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ret = ucm_orig_zeMemAllocShared(context, device_desc, host_desc, size,
                                     alignment, device, ptr);
@@ -156,15 +159,16 @@ ze_result_t ucm_zeMemAllocShared(ze_context_handle_t context,
         ucm_dispatch_mem_type_alloc(*ptr, size, UCS_MEMORY_TYPE_ZE_MANAGED);
     }
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
     return ret;
 }
 
 ze_result_t ucm_zeMemFree(ze_context_handle_t context, void *ptr)
 {
     ze_result_t ret;
+    unsigned epoch;
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
 
     ucm_trace("ucm_zeMemFree(context=%p, ptr=%p)", context, ptr);
 
@@ -172,7 +176,7 @@ ze_result_t ucm_zeMemFree(ze_context_handle_t context, void *ptr)
 
     ret = ucm_orig_zeMemFree(context, ptr);
 
-    ucm_event_leave();
+    ucm_event_leave(epoch);
     return ret;
 }
 
@@ -225,6 +229,7 @@ static int ucm_zemem_scan_regions_cb(void *arg, void *addr, size_t length,
     static const char *ze_path_pattern = "/dev/dri";
     ucm_event_handler_t *handler       = arg;
     ucm_event_t event;
+    unsigned epoch;
 
     if ((prot & (PROT_READ | PROT_WRITE | PROT_EXEC)) &&
         strncmp(path, ze_path_pattern, strlen(ze_path_pattern))) {
@@ -238,9 +243,9 @@ static int ucm_zemem_scan_regions_cb(void *arg, void *addr, size_t length,
     event.mem_type.size     = length;
     event.mem_type.mem_type = UCS_MEMORY_TYPE_LAST; /* unknown memory type */
 
-    ucm_event_enter();
+    epoch = ucm_event_enter();
     handler->cb(UCM_EVENT_MEM_TYPE_ALLOC, &event, handler->arg);
-    ucm_event_leave();
+    ucm_event_leave(epoch);
 
     return 0;
 }
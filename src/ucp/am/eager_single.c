@@ -12,6 +12,7 @@
 
 #include <ucp/core/ucp_request.h>
 #include <ucp/core/ucp_am.h>
+#include <ucp/core/ucp_fast_path.inl>
 #include <ucp/proto/proto_common.inl>
 #include <ucp/proto/proto_single.h>
 #include <ucp/proto/proto_single.inl>
@@ -69,9 +70,9 @@ ucp_am_eager_short_proto_progress_common(uct_pending_req_t *self, int is_reply)
         am_id = UCP_AM_ID_AM_SINGLE;
     }
 
-    status = uct_ep_am_short_iov(ucp_ep_get_fast_lane(req->send.ep,
-                                                      spriv->super.lane),
-                                 am_id, iov, iov_cnt);
+    status = ucp_uct_ep_am_short_iov(ucp_ep_get_fast_lane(req->send.ep,
+                                                          spriv->super.lane),
+                                     am_id, iov, iov_cnt);
     status = ucp_proto_am_handle_user_header_send_status(req, status);
     if (ucs_unlikely(status == UCS_ERR_NO_RESOURCE)) {
         req->send.lane = spriv->super.lane; /* for pending add */
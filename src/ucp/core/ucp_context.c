@@ -97,6 +97,13 @@ static const char *ucp_fence_modes[] = {
     [UCP_FENCE_MODE_LAST]   = NULL
 };
 
+static const char *ucp_numa_bind_modes[] = {
+    [UCP_NUMA_BIND_NONE]   = "none",
+    [UCP_NUMA_BIND_CPU]    = "cpu",
+    [UCP_NUMA_BIND_DEVICE] = "device",
+    [UCP_NUMA_BIND_LAST]   = NULL
+};
+
 static const char *ucp_rndv_modes[] = {
     [UCP_RNDV_MODE_AUTO]         = "auto",
     [UCP_RNDV_MODE_GET_ZCOPY]    = "get_zcopy",
@@ -368,6 +375,18 @@ static ucs_config_field_t ucp_context_config_table[] = {
    ucs_offsetof(ucp_context_config_t, fence_mode),
    UCS_CONFIG_TYPE_ENUM(ucp_fence_modes)},
 
+  {"WORKER_NUMA_BIND", "none",
+   "NUMA node to allocate worker memory pools, such as bounce buffers and\n"
+   "rendezvous fragments, on:\n"
+   " none   - use the default memory policy.\n"
+   " cpu    - node of the CPU which creates the worker.\n"
+   " device - node of most of the worker devices; if the devices have no\n"
+   "          NUMA node, fall back to 'cpu'.\n"
+   "A warning is printed if the worker devices are on a different node than\n"
+   "the CPU which creates the worker.",
+   ucs_offsetof(ucp_context_config_t, numa_bind),
+   UCS_CONFIG_TYPE_ENUM(ucp_numa_bind_modes)},
+
   {"UNIFIED_MODE", "n",
    "Enable various optimizations intended for homogeneous environment.\n"
    "Enabling this mode implies that the local transport resources/devices\n"
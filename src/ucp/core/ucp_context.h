@@ -121,6 +121,8 @@ typedef struct ucp_context_config {
     int                                    flush_worker_eps;
     /** Fence mode */
     ucp_fence_mode_t                       fence_mode;
+    /** NUMA node selection for worker memory pools */
+    ucp_numa_bind_t                        numa_bind;
     /** Enable optimizations suitable for homogeneous systems */
     int                                    unified_mode;
     /** Enable cm wireup message exchange to select the best transports
@@ -424,6 +426,8 @@ typedef struct ucp_am_handler {
     ucp_am_tracer_t               tracer;
     uint32_t                      flags;
     uct_am_callback_t             proxy_cb;
+    uct_am_recv_into_callback_t   recv_into_cb;
+    size_t                        recv_into_hdr_length;
 } ucp_am_handler_t;
 
 typedef struct ucp_tl_iface_atomic_flags {
@@ -449,13 +453,30 @@ typedef struct ucp_tl_iface_atomic_flags {
 /*
  * Define UCP active message handler helper macro.
  */
-#define _UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags, _proxy) \
+#define _UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags, _proxy, \
+                       _recv_into, _recv_into_hdr_length) \
     ucp_am_handler_t ucp_am_handler_##_id  = { \
-        .features = _features, \
-        .cb       = _cb, \
-        .tracer   = _tracer, \
-        .flags    = _flags, \
-        .proxy_cb = _proxy \
+        .features             = _features, \
+        .cb                   = _cb, \
+        .tracer               = _tracer, \
+        .flags                = _flags, \
+        .proxy_cb             = _proxy, \
+        .recv_into_cb         = _recv_into, \
+        .recv_into_hdr_length = _recv_into_hdr_length \
+    }
+
+
+/*
+ * Define a proxy handler which counts received messages.
+ */
+#define _UCP_DEFINE_AM_COUNTING_PROXY(_id, _cb) \
+    static ucs_status_t \
+    ucp_am_##_id##_counting_proxy(void *arg, void *data, size_t length, \
+                                  unsigned flags) \
+    { \
+        ucp_worker_iface_t *wiface = arg; \
+        wiface->proxy_recv_count++; \
+        return _cb(wiface->worker, data, length, flags); \
     }
 
 
@@ -463,7 +484,7 @@ typedef struct ucp_tl_iface_atomic_flags {
  * Define UCP active message handler.
  */
 #define UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags) \
-    _UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags, NULL)
+    _UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags, NULL, NULL, 0)
 
 
 /**
@@ -472,18 +493,21 @@ typedef struct ucp_tl_iface_atomic_flags {
  * activity on a transport interface.
  */
 #define UCP_DEFINE_AM_WITH_PROXY(_features, _id, _cb, _tracer, _flags) \
-    \
-    static ucs_status_t \
-    ucp_am_##_id##_counting_proxy(void *arg, void *data, size_t length, \
-                                  unsigned flags) \
-    { \
-        ucp_worker_iface_t *wiface = arg; \
-        wiface->proxy_recv_count++; \
-        return _cb(wiface->worker, data, length, flags); \
-    } \
-    \
+    _UCP_DEFINE_AM_COUNTING_PROXY(_id, _cb) \
+    _UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags, \
+                   ucp_am_##_id##_counting_proxy, NULL, 0)
+
+
+/**
+ * Defines UCP active message handler with proxy handler, which also provides
+ * user buffers to receive the payload of the messages after a header of
+ * @a _hdr_length bytes. See @ref uct_am_recv_into_callback_t.
+ */
+#define UCP_DEFINE_AM_WITH_PROXY_RECV_INTO(_features, _id, _cb, _tracer, \
+                                           _flags, _recv_into, _hdr_length) \
+    _UCP_DEFINE_AM_COUNTING_PROXY(_id, _cb) \
     _UCP_DEFINE_AM(_features, _id, _cb, _tracer, _flags, \
-                   ucp_am_##_id##_counting_proxy)
+                   ucp_am_##_id##_counting_proxy, _recv_into, _hdr_length)
 
 
 #define UCP_CHECK_PARAM_NON_NULL(_param, _status, _action) \
@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifndef UCP_FAST_PATH_INL_
+#define UCP_FAST_PATH_INL_
+
+#include <uct/api/uct.h>
+#include <ucs/sys/compiler_def.h>
+
+#if UCP_FAST_PATH_TCP
+#include <uct/tcp/tcp.h>
+#endif
+#if UCP_FAST_PATH_MM
+#include <uct/sm/mm/base/mm_ep.h>
+#endif
+
+
+/*
+ * Short sends on the UCP fast path. When UCX is configured with
+ * --with-ucp-fast-path, the transports selected at build time are called
+ * directly if the endpoint belongs to them, and any other transport goes
+ * through the interface operations table as usual.
+ */
+#define UCP_FAST_PATH_ENABLED (UCP_FAST_PATH_TCP || UCP_FAST_PATH_MM)
+
+
+#define UCP_FAST_PATH_CALL(_uct_ep, _op, _tl_func, ...) \
+    if (ucs_likely((_uct_ep)->iface->ops._op == (_tl_func))) { \
+        return _tl_func(_uct_ep, ## __VA_ARGS__); \
+    }
+
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_uct_ep_am_short(uct_ep_h uct_ep, uint8_t id, uint64_t header,
+                    const void *payload, unsigned length)
+{
+#if UCP_FAST_PATH_TCP
+    UCP_FAST_PATH_CALL(uct_ep, ep_am_short, uct_tcp_ep_am_short, id, header,
+                       payload, length);
+#endif
+#if UCP_FAST_PATH_MM
+    UCP_FAST_PATH_CALL(uct_ep, ep_am_short, uct_mm_ep_am_short, id, header,
+                       payload, length);
+#endif
+    return uct_ep_am_short(uct_ep, id, header, payload, length);
+}
+
+
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_uct_ep_am_short_iov(uct_ep_h uct_ep, uint8_t id, const uct_iov_t *iov,
+                        size_t iovcnt)
+{
+#if UCP_FAST_PATH_TCP
+    UCP_FAST_PATH_CALL(uct_ep, ep_am_short_iov, uct_tcp_ep_am_short_iov, id,
+                       iov, iovcnt);
+#endif
+#if UCP_FAST_PATH_MM
+    UCP_FAST_PATH_CALL(uct_ep, ep_am_short_iov, uct_mm_ep_am_short_iov, id,
+                       iov, iovcnt);
+#endif
+    return uct_ep_am_short_iov(uct_ep, id, iov, iovcnt);
+}
+
+#endif
@@ -323,11 +323,17 @@ ucs_mpool_ops_t ucp_rndv_get_mpool_ops = {
 
 int ucp_request_pending_add(ucp_request_t *req)
 {
+    unsigned flags = 0;
     ucs_status_t status;
     uct_ep_h uct_ep;
 
+    if (ucs_unlikely(req->flags & UCP_REQUEST_FLAG_PENDING_PRIO)) {
+        req->flags &= ~UCP_REQUEST_FLAG_PENDING_PRIO;
+        flags       = UCT_CB_FLAG_PRIORITY;
+    }
+
     uct_ep = ucp_ep_get_lane(req->send.ep, req->send.lane);
-    status = uct_ep_pending_add(uct_ep, &req->send.uct, 0);
+    status = uct_ep_pending_add(uct_ep, &req->send.uct, flags);
     if (status == UCS_OK) {
         ucs_trace_data("ep %p: added pending uct request %p to lane[%d]=%p",
                        req->send.ep, req, req->send.lane, uct_ep);
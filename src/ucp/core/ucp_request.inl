@@ -319,6 +319,27 @@ static int UCS_F_ALWAYS_INLINE ucp_request_try_send(ucp_request_t *req)
     ucs_fatal("unexpected error: %s", ucs_status_string(status));
 }
 
+/**
+ * Handle the send status of a control message, such as a rendezvous or wireup
+ * protocol message. If the message could not be sent because of lack of
+ * resources, the request is marked to be added to the pending queue ahead of
+ * bulk data requests.
+ *
+ * @param [in]  req     Request which sends the control message.
+ * @param [in]  status  Send status.
+ *
+ * @return The send status.
+ */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_request_ctrl_send_status(ucp_request_t *req, ucs_status_t status)
+{
+    if (ucs_unlikely(status == UCS_ERR_NO_RESOURCE)) {
+        req->flags |= UCP_REQUEST_FLAG_PENDING_PRIO;
+    }
+
+    return status;
+}
+
 /**
  * Start sending a request.
  *
@@ -756,7 +756,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rkey_proto_resolve,
     const void *p       = buffer;
     ucs_sys_dev_distance_t *lanes_distance;
     ucp_rkey_config_key_t rkey_config_key;
-    khiter_t khiter;
+    ucs_swiss_hash_iter_t iter;
 
     /* Avoid calling ucp_ep_resolve_remote_id() from rkey_unpack, and let
      * the APIs which are not yet using new protocols resolve the remote key
@@ -776,11 +776,11 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_rkey_proto_resolve,
         rkey_config_key.sys_dev = UCS_SYS_DEVICE_ID_UNKNOWN;
     }
 
-    khiter = kh_get(ucp_worker_rkey_config, &worker->rkey_config_hash,
-                    rkey_config_key);
-    if (ucs_likely(khiter != kh_end(&worker->rkey_config_hash))) {
+    iter = ucs_swiss_hash_get(ucp_worker_rkey_config, &worker->rkey_config_hash,
+                              rkey_config_key);
+    if (ucs_likely(iter != ucs_swiss_hash_end(&worker->rkey_config_hash))) {
         /* Found existing configuration in hash */
-        rkey->cfg_index = kh_val(&worker->rkey_config_hash, khiter);
+        rkey->cfg_index = ucs_swiss_hash_value(&worker->rkey_config_hash, iter);
         return UCS_OK;
     }
 
@@ -228,6 +228,17 @@ typedef enum {
 } ucp_fence_mode_t;
 
 
+/**
+ * NUMA node to allocate worker memory pools on.
+ */
+typedef enum {
+    UCP_NUMA_BIND_NONE,   /* Use the default memory policy */
+    UCP_NUMA_BIND_CPU,    /* Node of the CPU which creates the worker */
+    UCP_NUMA_BIND_DEVICE, /* Node of the worker devices */
+    UCP_NUMA_BIND_LAST
+} ucp_numa_bind_t;
+
+
 /**
  * Communication scheme in RNDV protocol.
  */
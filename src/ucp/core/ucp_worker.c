@@ -221,6 +221,16 @@ static void ucp_worker_set_am_handlers(ucp_worker_iface_t *wiface, int is_proxy)
             ucs_fatal("failed to set active message handler id %d: %s", am_id,
                       ucs_status_string(status));
         }
+
+        if (ucp_am_handlers[am_id]->recv_into_cb != NULL) {
+            status = uct_iface_set_am_recv_into_handler(
+                    wiface->iface, am_id, ucp_am_handlers[am_id]->recv_into_cb,
+                    worker, ucp_am_handlers[am_id]->recv_into_hdr_length);
+            if (status != UCS_OK) {
+                ucs_fatal("failed to set active message receive handler "
+                          "id %d: %s", am_id, ucs_status_string(status));
+            }
+        }
     }
 }
 
@@ -1901,6 +1911,69 @@ ucp_worker_print_used_tls(ucp_worker_h worker, ucp_worker_cfg_index_t cfg_index)
     ucs_info("%s", ucs_string_buffer_cstr(&strb));
 }
 
+static ucs_numa_node_t ucp_worker_devices_numa_node(ucp_worker_h worker)
+{
+    ucs_numa_node_t numa_node = UCS_NUMA_NODE_UNDEFINED;
+    unsigned max_count        = 0;
+    unsigned num_nodes        = 0;
+    ucs_numa_node_t nodes[UCP_MAX_RESOURCES];
+    unsigned counts[UCP_MAX_RESOURCES];
+    ucp_rsc_index_t iface_id;
+    ucs_numa_node_t node;
+    unsigned i;
+
+    /* Select the node which most of the devices are attached to */
+    for (iface_id = 0; iface_id < worker->num_ifaces; ++iface_id) {
+        node = ucs_topo_sys_device_get_numa_node(
+                ucp_worker_iface_get_sys_device(worker->ifaces[iface_id]));
+        if (node == UCS_NUMA_NODE_UNDEFINED) {
+            continue;
+        }
+
+        for (i = 0; (i < num_nodes) && (nodes[i] != node); ++i);
+        if (i == num_nodes) {
+            nodes[num_nodes]    = node;
+            counts[num_nodes++] = 0;
+        }
+
+        if (++counts[i] > max_count) {
+            max_count = counts[i];
+            numa_node = node;
+        }
+    }
+
+    return numa_node;
+}
+
+static void ucp_worker_init_numa_node(ucp_worker_h worker)
+{
+    ucp_numa_bind_t numa_bind = worker->context->config.ext.numa_bind;
+    ucs_numa_node_t cpu_node, dev_node;
+
+    worker->numa_node = UCS_NUMA_NODE_UNDEFINED;
+    if (numa_bind == UCP_NUMA_BIND_NONE) {
+        return;
+    }
+
+    cpu_node = ucs_numa_node_of_current_cpu();
+    dev_node = ucp_worker_devices_numa_node(worker);
+    if ((cpu_node != UCS_NUMA_NODE_UNDEFINED) &&
+        (dev_node != UCS_NUMA_NODE_UNDEFINED) && (cpu_node != dev_node)) {
+        ucs_warn("worker %s: created on a CPU of NUMA node %d, but its devices "
+                 "are on NUMA node %d", worker->name, cpu_node, dev_node);
+    }
+
+    if ((numa_bind == UCP_NUMA_BIND_DEVICE) &&
+        (dev_node != UCS_NUMA_NODE_UNDEFINED)) {
+        worker->numa_node = dev_node;
+    } else {
+        worker->numa_node = cpu_node;
+    }
+
+    ucs_debug("worker %s: memory pools are allocated on NUMA node %d",
+              worker->name, worker->numa_node);
+}
+
 static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
 {
     size_t           max_mp_entry_size = 0;
@@ -1920,6 +1993,8 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
                                     if_attr->cap.am.max_zcopy);
     }
 
+    ucp_worker_init_numa_node(worker);
+
     /* Create a hashtable of memory pools for mem_type devices */
     kh_init_inplace(ucp_worker_mpool_hash, &worker->mpool_hash);
 
@@ -1929,6 +2004,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     mp_params.elems_per_chunk = 128;
     mp_params.ops             = &ucp_request_mpool_ops;
     mp_params.name            = "ucp_requests";
+    mp_params.numa_node       = worker->numa_node;
     /* Create memory pool for requests */
     status = ucs_mpool_init(&mp_params, &worker->req_mp);
     if (status != UCS_OK) {
@@ -1971,6 +2047,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         mp_params.elems_per_chunk = 128;
         mp_params.ops             = &ucp_rkey_mpool_ops;
         mp_params.name            = "ucp_rkeys";
+        mp_params.numa_node       = worker->numa_node;
         status = ucs_mpool_init(&mp_params, &worker->rkey_mp);
         if (status != UCS_OK) {
             goto err_req_mp_cleanup;
@@ -1983,6 +2060,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
     mp_params.elems_per_chunk = 128;
     mp_params.ops             = &ucp_reg_mpool_ops;
     mp_params.name            = "ucp_reg_bufs";
+    mp_params.numa_node       = worker->numa_node;
     /* Create memory pool of bounce buffers */
     status = ucs_mpool_init(&mp_params, &worker->reg_mp);
     if (status != UCS_OK) {
@@ -2001,6 +2079,7 @@ static ucs_status_t ucp_worker_init_mpools(ucp_worker_h worker)
         if (status != UCS_OK) {
             goto err_reg_mp_cleanup;
         }
+        ucs_mpool_set_numa_bind(&worker->am_mps, worker->numa_node);
         worker->flags |= UCP_WORKER_FLAG_AM_MPOOL_INITIALIZED;
     }
 
@@ -2140,10 +2219,10 @@ ucp_worker_add_rkey_config(ucp_worker_h worker,
     ucp_worker_cfg_index_t rkey_cfg_index;
     ucp_rkey_config_t *rkey_config;
     ucp_lane_index_t lane;
+    ucs_swiss_hash_iter_t iter;
     ucs_status_t status;
-    khiter_t khiter;
     char buf[128];
-    int khret;
+    int ret;
 
     ucs_assert(worker->context->config.ext.proto_enable);
 
@@ -2175,16 +2254,16 @@ ucp_worker_add_rkey_config(ucp_worker_h worker,
     }
 
     /* Save key-to-index lookup */
-    khiter = kh_put(ucp_worker_rkey_config, &worker->rkey_config_hash, *key,
-                    &khret);
-    if (khret == UCS_KH_PUT_FAILED) {
+    iter = ucs_swiss_hash_put(ucp_worker_rkey_config, &worker->rkey_config_hash,
+                              *key, &ret);
+    if (ret == UCS_SWISS_HASH_PUT_FAILED) {
         status = UCS_ERR_NO_MEMORY;
         goto err;
     }
 
     /* We should not get into this function if key already exists */
-    ucs_assert_always(khret != UCS_KH_PUT_KEY_PRESENT);
-    kh_value(&worker->rkey_config_hash, khiter) = rkey_cfg_index;
+    ucs_assert_always(ret != UCS_SWISS_HASH_PUT_KEY_PRESENT);
+    ucs_swiss_hash_value(&worker->rkey_config_hash, iter) = rkey_cfg_index;
 
     /* Initialize protocol selection */
     status = ucp_proto_select_init(&rkey_config->proto_select);
@@ -2208,7 +2287,7 @@ ucp_worker_add_rkey_config(ucp_worker_h worker,
     return UCS_OK;
 
 err_kh_del:
-    kh_del(ucp_worker_rkey_config, &worker->rkey_config_hash, khiter);
+    ucs_swiss_hash_del(ucp_worker_rkey_config, &worker->rkey_config_hash, iter);
 err:
     return status;
 }
@@ -2472,7 +2551,7 @@ ucs_status_t ucp_worker_create(ucp_context_h context,
     ucs_list_head_init(&worker->stream_ready_eps);
     ucs_list_head_init(&worker->all_eps);
     ucs_list_head_init(&worker->internal_eps);
-    kh_init_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucs_swiss_hash_init(ucp_worker_rkey_config, &worker->rkey_config_hash);
     kh_init_inplace(ucp_worker_discard_uct_ep_hash, &worker->discard_uct_ep_hash);
     worker->counters.ep_creations         = 0;
     worker->counters.ep_creation_failures = 0;
@@ -2683,7 +2762,7 @@ err_free:
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
-    kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucs_swiss_hash_destroy(ucp_worker_rkey_config, &worker->rkey_config_hash);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
     return status;
@@ -2933,7 +3012,7 @@ void ucp_worker_destroy(ucp_worker_h worker)
     ucs_strided_alloc_cleanup(&worker->ep_alloc);
     kh_destroy_inplace(ucp_worker_discard_uct_ep_hash,
                        &worker->discard_uct_ep_hash);
-    kh_destroy_inplace(ucp_worker_rkey_config, &worker->rkey_config_hash);
+    ucs_swiss_hash_destroy(ucp_worker_rkey_config, &worker->rkey_config_hash);
     ucp_worker_destroy_configs(worker);
     ucs_free(worker);
 }
@@ -21,6 +21,7 @@
 #include <ucs/datastruct/strided_alloc.h>
 #include <ucs/datastruct/conn_match.h>
 #include <ucs/datastruct/ptr_map.h>
+#include <ucs/datastruct/swiss_hash.h>
 #include <ucs/datastruct/usage_tracker.h>
 #include <ucs/arch/bitops.h>
 
@@ -205,8 +206,9 @@ enum {
 
 
 /* Hash map to find rkey config index by rkey config key, for fast rkey unpack */
-KHASH_TYPE(ucp_worker_rkey_config, ucp_rkey_config_key_t, ucp_worker_cfg_index_t);
-typedef khash_t(ucp_worker_rkey_config) ucp_worker_rkey_config_hash_t;
+UCS_SWISS_HASH_TYPE(ucp_worker_rkey_config, ucp_rkey_config_key_t,
+                    ucp_worker_cfg_index_t);
+typedef ucs_swiss_hash_t(ucp_worker_rkey_config) ucp_worker_rkey_config_hash_t;
 
 
 /* Hash map of UCT EPs that are being discarded on UCP Worker */
@@ -329,6 +331,8 @@ typedef struct ucp_worker {
 
     ucs_cpu_set_t                    cpu_mask;            /* Save CPU mask for subsequent calls to
                                                              ucp_worker_listen */
+    ucs_numa_node_t                  numa_node;           /* NUMA node to allocate memory
+                                                             pools on */
 
     ucp_worker_rkey_config_hash_t    rkey_config_hash;    /* RKEY config key -> index */
     ucp_worker_discard_uct_ep_hash_t discard_uct_ep_hash; /* Hash of discarded UCT EPs */
@@ -273,14 +273,18 @@ void ucp_proto_select_info(ucp_worker_h worker,
                            const ucp_proto_select_t *proto_select, int show_all,
                            ucs_string_buffer_t *strb)
 {
-    ucp_proto_select_elem_t select_elem;
+    ucs_swiss_hash_iter_t iter;
     ucp_proto_select_key_t key;
 
-    kh_foreach(proto_select->hash, key.u64, select_elem,
-               ucp_proto_select_elem_info(worker, ep_cfg_index, rkey_cfg_index,
-                                          &key.param, &select_elem, show_all,
-                                          strb);
-               ucs_string_buffer_appendf(strb, "\n"))
+    ucs_swiss_hash_for_each(&proto_select->hash, iter) {
+        key.u64 = ucs_swiss_hash_key(&proto_select->hash, iter);
+        ucp_proto_select_elem_info(worker, ep_cfg_index, rkey_cfg_index,
+                                   &key.param,
+                                   &ucs_swiss_hash_value(&proto_select->hash,
+                                                         iter),
+                                   show_all, strb);
+        ucs_string_buffer_appendf(strb, "\n");
+    }
 }
 
 void ucp_proto_select_dump_short(const ucp_proto_select_short_t *select_short,
@@ -596,14 +596,15 @@ ucp_proto_select_lookup_slow(ucp_worker_h worker,
 {
     ucp_proto_select_elem_t *select_elem, tmp_select_elem;
     ucp_proto_select_key_t key;
+    ucs_swiss_hash_iter_t iter;
     ucs_status_t status;
-    khiter_t khiter;
-    int khret;
+    int ret;
 
     key.param = *select_param;
-    khiter    = kh_get(ucp_proto_select_hash, proto_select->hash, key.u64);
-    if (khiter != kh_end(proto_select->hash)) {
-        select_elem = &kh_value(proto_select->hash, khiter);
+    iter      = ucs_swiss_hash_get(ucp_proto_select_hash, &proto_select->hash,
+                                   key.u64);
+    if (iter != ucs_swiss_hash_end(&proto_select->hash)) {
+        select_elem = &ucs_swiss_hash_value(&proto_select->hash, iter);
         goto out;
     }
 
@@ -617,11 +618,11 @@ ucp_proto_select_lookup_slow(ucp_worker_h worker,
     /* add to hash after initializing the temp element, since calling
      * ucp_proto_select_elem_init() can recursively modify the hash
      */
-    khiter = kh_put(ucp_proto_select_hash, proto_select->hash, key.u64,
-                    &khret);
-    ucs_assert_always(khret == UCS_KH_PUT_BUCKET_EMPTY);
+    iter = ucs_swiss_hash_put(ucp_proto_select_hash, &proto_select->hash,
+                              key.u64, &ret);
+    ucs_assert_always(ret == UCS_SWISS_HASH_PUT_BUCKET_EMPTY);
 
-    select_elem  = &kh_value(proto_select->hash, khiter);
+    select_elem  = &ucs_swiss_hash_value(&proto_select->hash, iter);
     *select_elem = tmp_select_elem;
 
     /* Adding hash values may reallocate the array, so the cached pointer to
@@ -635,23 +636,20 @@ out:
 
 ucs_status_t ucp_proto_select_init(ucp_proto_select_t *proto_select)
 {
-    proto_select->hash = kh_init(ucp_proto_select_hash);
-    if (proto_select->hash == NULL) {
-        return UCS_ERR_NO_MEMORY;
-    }
-
+    ucs_swiss_hash_init(ucp_proto_select_hash, &proto_select->hash);
     ucp_proto_select_cache_reset(proto_select);
     return UCS_OK;
 }
 
 void ucp_proto_select_cleanup(ucp_proto_select_t *proto_select)
 {
-    ucp_proto_select_elem_t select_elem;
+    ucs_swiss_hash_iter_t iter;
 
-    kh_foreach_value(proto_select->hash, select_elem,
-         ucp_proto_select_elem_cleanup(&select_elem)
-    )
-    kh_destroy(ucp_proto_select_hash, proto_select->hash);
+    ucs_swiss_hash_for_each(&proto_select->hash, iter) {
+        ucp_proto_select_elem_cleanup(
+                &ucs_swiss_hash_value(&proto_select->hash, iter));
+    }
+    ucs_swiss_hash_destroy(ucp_proto_select_hash, &proto_select->hash);
 }
 
 void ucp_proto_select_add_proto(const ucp_proto_init_params_t *init_params,
@@ -9,8 +9,8 @@
 
 #include "proto.h"
 
-#include <ucs/datastruct/khash.h>
 #include <ucs/datastruct/array.h>
+#include <ucs/datastruct/swiss_hash.h>
 
 
 /**
@@ -139,7 +139,7 @@ typedef struct {
 
 
 /* Hash type of mapping a buffer-type (key) to a protocol selection */
-KHASH_TYPE(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t)
+UCS_SWISS_HASH_TYPE(ucp_proto_select_hash, uint64_t, ucp_proto_select_elem_t)
 
 
 /**
@@ -147,7 +147,7 @@ KHASH_TYPE(ucp_proto_select_hash, khint64_t, ucp_proto_select_elem_t)
  */
 typedef struct {
     /* Lookup from protocol selection key to thresholds array */
-    khash_t(ucp_proto_select_hash)    *hash;
+    ucs_swiss_hash_t(ucp_proto_select_hash) hash;
 
     /* cache the last used protocol, for fast lookup */
     struct {
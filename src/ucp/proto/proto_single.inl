@@ -10,6 +10,7 @@
 #include "proto_single.h"
 #include "proto_common.inl"
 
+#include <ucp/core/ucp_fast_path.inl>
 #include <ucp/dt/datatype_iter.inl>
 
 
@@ -38,8 +39,8 @@ ucp_proto_am_bcopy_single_send(ucp_request_t *req, ucp_am_id_t am_id,
         ucs_assertv((packed_size >= 0) && (packed_size <= max_packed_size),
                     "packed_size=%zd max_packed_size=%zu", packed_size,
                     max_packed_size);
-        return uct_ep_am_short(uct_ep, am_id, buffer[0],
-                               &buffer[1], packed_size - sizeof(buffer[0]));
+        return ucp_uct_ep_am_short(uct_ep, am_id, buffer[0], &buffer[1],
+                                   packed_size - sizeof(buffer[0]));
     } else {
         /* Send as bcopy */
         packed_size = uct_ep_am_bcopy(uct_ep, am_id, pack_func,
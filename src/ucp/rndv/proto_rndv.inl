@@ -143,10 +143,13 @@ static size_t UCS_F_ALWAYS_INLINE ucp_proto_rndv_ack_progress(
         ucp_am_id_t am_id, uct_pack_callback_t pack_func,
         ucp_proto_complete_cb_t complete_func)
 {
-    return ucp_proto_am_bcopy_single_progress(req, am_id, apriv->lane,
-                                              pack_func, req,
-                                              sizeof(ucp_rndv_ack_hdr_t),
-                                              complete_func, 0);
+    ucs_status_t status;
+
+    status = ucp_proto_am_bcopy_single_progress(req, am_id, apriv->lane,
+                                                pack_func, req,
+                                                sizeof(ucp_rndv_ack_hdr_t),
+                                                complete_func, 0);
+    return ucp_request_ctrl_send_status(req, status);
 }
 
 static UCS_F_ALWAYS_INLINE void
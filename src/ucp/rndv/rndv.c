@@ -1148,6 +1148,9 @@ ucp_rndv_mpool_get(ucp_worker_h worker, ucs_memory_type_t mem_type,
     mp_params.elems_per_chunk = num_frags;
     mp_params.ops             = &ucp_frag_mpool_ops;
     mp_params.name            = "ucp_rndv_frags";
+    if (mem_type == UCS_MEMORY_TYPE_HOST) {
+        mp_params.numa_node = worker->numa_node;
+    }
     status = ucs_mpool_init(&mp_params, mpool);
     if (status != UCS_OK) {
         return NULL;
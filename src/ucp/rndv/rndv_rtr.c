@@ -55,7 +55,7 @@ static ucs_status_t ucp_proto_rndv_rtr_common_send(ucp_request_t *req)
         UCP_WORKER_STAT_RNDV(worker, RTR, +1);
     }
 
-    return status;
+    return ucp_request_ctrl_send_status(req, status);
 }
 
 static UCS_F_ALWAYS_INLINE void
@@ -156,6 +156,70 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_first_handler,
                                     "eager_first_handler");
 }
 
+/* Provide the user buffer of an expected request to receive the payload of a
+ * middle fragment of SW eager message to, if the fragment can be placed there
+ * as is */
+static void *
+ucp_eager_middle_recv_into(void *arg, const void *data, size_t length)
+{
+    ucp_worker_h worker               = arg;
+    const ucp_eager_middle_hdr_t *hdr = data;
+    size_t recv_len                   = length - sizeof(*hdr);
+    ucp_tag_frag_match_t *matchq;
+    ucp_datatype_iter_t *dt_iter;
+    ucp_request_t *req;
+    khiter_t iter;
+
+    iter = kh_get(ucp_tag_frag_hash, &worker->tm.frag_hash, hdr->msg_id);
+    if (iter == kh_end(&worker->tm.frag_hash)) {
+        return NULL;
+    }
+
+    matchq = &kh_value(&worker->tm.frag_hash, iter);
+    if (ucp_tag_frag_match_is_unexp(matchq)) {
+        return NULL;
+    }
+
+    /* The request can't be completed until the fragment is delivered, so the
+     * buffer remains valid */
+    req     = matchq->exp_req;
+    dt_iter = &req->recv.dt_iter;
+    if ((req->status != UCS_OK) ||
+        (dt_iter->dt_class != UCP_DATATYPE_CONTIG) ||
+        !UCP_MEM_IS_HOST(dt_iter->mem_info.type) ||
+        ((hdr->offset + recv_len) > dt_iter->length)) {
+        return NULL;
+    }
+
+    ucp_trace_req(req, "recv_into offset %zu length %zu", hdr->offset,
+                  recv_len);
+    return UCS_PTR_BYTE_OFFSET(dt_iter->type.contig.buffer, hdr->offset);
+}
+
+/* Account a middle fragment which was received to the user buffer */
+static UCS_F_ALWAYS_INLINE ucs_status_t
+ucp_eager_middle_recv_into_complete(ucp_request_t *req, size_t recv_len)
+{
+    ucs_status_t status;
+
+    ucs_assertv(req->recv.remaining >= recv_len,
+                "req->recv.remaining=%zu recv_len=%zu",
+                req->recv.remaining, recv_len);
+
+    req->recv.remaining -= recv_len;
+    if (req->recv.remaining != 0) {
+        return UCS_INPROGRESS;
+    }
+
+    status = req->status;
+    if (status == UCS_OK) {
+        ucp_datatype_iter_cleanup(&req->recv.dt_iter, 0, UCP_DT_MASK_ALL);
+    }
+
+    ucp_request_complete_tag_recv(req, status);
+    return status;
+}
+
 /* Handler for middle fragments of SW eager messages */
 UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_middle_handler,
                  (arg, data, length, am_flags),
@@ -180,6 +244,8 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_middle_handler,
     }
 
     if (ucp_tag_frag_match_is_unexp(matchq)) {
+        ucs_assert(!(am_flags & UCT_CB_PARAM_FLAG_RECV_INTO));
+
         /* add new received descriptor to the queue */
         status = ucp_recv_desc_init(worker, data, length, 0, am_flags,
                                     sizeof(*hdr), UCP_RECV_DESC_FLAG_EAGER, 0,
@@ -206,8 +272,12 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_eager_middle_handler,
 
         UCP_WORKER_STAT_EAGER_CHUNK(worker, EXP);
 
-        status = ucp_request_process_recv_data(req, hdr + 1, recv_len,
-                                               hdr->offset, 0, 0);
+        if (ucs_unlikely(am_flags & UCT_CB_PARAM_FLAG_RECV_INTO)) {
+            status = ucp_eager_middle_recv_into_complete(req, recv_len);
+        } else {
+            status = ucp_request_process_recv_data(req, hdr + 1, recv_len,
+                                                   hdr->offset, 0, 0);
+        }
         if (status != UCS_INPROGRESS) {
             /* request completed, delete hash entry */
             kh_del(ucp_tag_frag_hash, &worker->tm.frag_hash, iter);
@@ -555,8 +625,10 @@ UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_ONLY,
                          ucp_eager_only_handler, ucp_eager_dump, 0);
 UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_FIRST,
                          ucp_eager_first_handler, ucp_eager_dump, 0);
-UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_MIDDLE,
-                         ucp_eager_middle_handler, ucp_eager_dump, 0);
+UCP_DEFINE_AM_WITH_PROXY_RECV_INTO(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_MIDDLE,
+                                   ucp_eager_middle_handler, ucp_eager_dump, 0,
+                                   ucp_eager_middle_recv_into,
+                                   sizeof(ucp_eager_middle_hdr_t));
 UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_SYNC_ONLY,
                         ucp_eager_sync_only_handler, ucp_eager_dump, 0);
 UCP_DEFINE_AM_WITH_PROXY(UCP_FEATURE_TAG, UCP_AM_ID_EAGER_SYNC_FIRST,
@@ -14,6 +14,7 @@
 #include <ucp/core/ucp_worker.h>
 #include <ucs/sys/string.h>
 
+#include <ucp/core/ucp_fast_path.inl>
 #include <ucp/core/ucp_request.inl>
 #include <ucp/proto/proto_single.inl>
 #include <ucp/proto/proto_common.inl>
@@ -26,11 +27,11 @@ static ucs_status_t ucp_eager_short_progress(uct_pending_req_t *self)
     const ucp_proto_single_priv_t *spriv = req->send.proto_config->priv;
     ucs_status_t status;
 
-    status = uct_ep_am_short(ucp_ep_get_fast_lane(req->send.ep,
-                                                  spriv->super.lane),
-                             UCP_AM_ID_EAGER_ONLY, req->send.msg_proto.tag,
-                             req->send.state.dt_iter.type.contig.buffer,
-                             req->send.state.dt_iter.length);
+    status = ucp_uct_ep_am_short(ucp_ep_get_fast_lane(req->send.ep,
+                                                      spriv->super.lane),
+                                 UCP_AM_ID_EAGER_ONLY, req->send.msg_proto.tag,
+                                 req->send.state.dt_iter.type.contig.buffer,
+                                 req->send.state.dt_iter.length);
     if (ucs_unlikely(status == UCS_ERR_NO_RESOURCE)) {
         req->send.lane = spriv->super.lane; /* for pending add */
         return status;
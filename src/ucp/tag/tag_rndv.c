@@ -150,7 +150,7 @@ UCS_PROFILE_FUNC(ucs_status_t, ucp_tag_rndv_rts_progress, (self),
         UCP_EP_STAT_TAG_OP(req->send.ep, RNDV);
     }
 
-    return status;
+    return ucp_request_ctrl_send_status(req, status);
 }
 
 static void ucp_tag_rndv_rts_probe(const ucp_proto_init_params_t *init_params)
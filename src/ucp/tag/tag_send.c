@@ -15,6 +15,7 @@
 #include <ucp/core/ucp_ep.h>
 #include <ucp/core/ucp_worker.h>
 #include <ucp/core/ucp_context.h>
+#include <ucp/core/ucp_fast_path.inl>
 #include <ucp/proto/proto_am.inl>
 #include <ucp/proto/proto_common.inl>
 #include <ucs/datastruct/mpool.inl>
@@ -157,9 +158,10 @@ ucp_tag_send_inline(ucp_ep_h ep, const void *buffer, size_t length,
                             length, param)) {
         UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(ucp_eager_hdr_t));
         UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(uint64_t));
-        status = uct_ep_am_short(ucp_ep_get_am_uct_ep(ep), UCP_AM_ID_EAGER_ONLY,
-                                 tag, buffer, length);
-    } else if (ucp_proto_is_inline(ep,
+        status = ucp_uct_ep_am_short(ucp_ep_get_am_uct_ep(ep),
+                                     UCP_AM_ID_EAGER_ONLY, tag, buffer, length);
+    } else if (!UCP_FAST_PATH_ENABLED &&
+               ucp_proto_is_inline(ep,
                                    &ucp_ep_config(ep)->tag.offload.max_eager_short,
                                    length, param)) {
         UCS_STATIC_ASSERT(sizeof(ucp_tag_t) == sizeof(uct_tag_t));
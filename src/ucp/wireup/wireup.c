@@ -151,6 +151,7 @@ ucs_status_t ucp_wireup_msg_progress(uct_pending_req_t *self)
     if (ucs_unlikely(packed_len < 0)) {
         status = (ucs_status_t)packed_len;
         if (ucs_likely(status == UCS_ERR_NO_RESOURCE)) {
+            ucp_request_ctrl_send_status(req, status);
             goto out;
         }
 
@@ -1695,7 +1696,7 @@ ucs_status_t ucp_wireup_connect_remote(ucp_ep_h ep, ucp_lane_index_t lane)
         status = uct_ep_pending_add(ucp_ep_get_lane(ep, lane), &req->send.uct,
                                     (req->send.uct.func == ucp_wireup_msg_progress) ||
                                     (req->send.uct.func == ucp_wireup_ep_progress_pending) ?
-                                    UCT_CB_FLAG_ASYNC : 0);
+                                    (UCT_CB_FLAG_ASYNC | UCT_CB_FLAG_PRIORITY) : 0);
         if (status != UCS_OK) {
             ucs_fatal("wireup proxy function must always return UCS_OK");
         }
@@ -38,6 +38,7 @@ ucs_global_opts_t ucs_global_opts = {
     .log_level_trigger     = UCS_LOG_LEVEL_FATAL,
     .warn_unused_env_vars  = 1,
     .enable_memtype_cache  = UCS_TRY,
+    .vma_query             = UCS_VMA_QUERY_AUTO,
     .async_signo           = SIGALRM,
     .stats_dest            = "",
     .tuning_path           = "",
@@ -151,6 +152,16 @@ static ucs_config_field_t ucs_global_opts_table[] = {
    "Enable memory type (cuda/rocm) cache",
    ucs_offsetof(ucs_global_opts_t, enable_memtype_cache), UCS_CONFIG_TYPE_TERNARY},
 
+ {"VMA_QUERY", "auto",
+  "Method for querying memory protection of virtual memory areas, used by the\n"
+  "registration cache:\n"
+  " auto  - use the best available method.\n"
+  " ioctl - PROCMAP_QUERY ioctl on /proc/self/maps (Linux 6.11 and above).\n"
+  " cache - sorted table of memory areas, invalidated by memory events.\n"
+  " parse - parse /proc/self/maps on every query.",
+  ucs_offsetof(ucs_global_opts_t, vma_query),
+  UCS_CONFIG_TYPE_ENUM(ucs_vma_query_names)},
+
  {"ASYNC_MAX_EVENTS", "1024",
   "The configuration parameter is deprecated.\n"
   "Now unlimited number of events can be handled from one context.",
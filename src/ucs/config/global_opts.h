@@ -79,6 +79,9 @@ typedef struct {
     /** Memtype cache */
     ucs_ternary_auto_value_t   enable_memtype_cache;
 
+    /* Method for querying memory protection */
+    ucs_vma_query_t            vma_query;
+
     /* Destination for statistics: udp:host:port / file:path / stdout
      */
     char                       *stats_dest;
@@ -48,6 +48,37 @@ KHASH_SET_INIT_STR(ucs_config_env_vars)
 
 KHASH_MAP_INIT_STR(ucs_config_map, char*)
 
+KHASH_MAP_INIT_STR(ucs_config_env_index, const char*)
+
+
+/* Result of a previous ucs_config_parser_fill_opts() call */
+typedef struct ucs_config_parser_memo {
+    ucs_list_link_t                      list;          /* Entry in memo list */
+    const ucs_config_global_list_entry_t *entry;        /* Parsed table entry */
+    ucs_config_field_t                   *table;        /* Parsed fields */
+    char                                 *table_prefix; /* Table prefix, or NULL */
+    char                                 *env_prefix;   /* Environment prefix */
+    int                                  ignore_errors; /* Parse mode */
+    uint64_t                             env_hash;      /* Environment used */
+    uint32_t                             generation;    /* Parser generation */
+    void                                 *opts;         /* Parsed options */
+} ucs_config_parser_memo_t;
+
+
+/*
+ * Parsing a configuration table looks up every field in the environment, so
+ * the results are memoized per table and prefix. The environment variables
+ * are looked up in an index, which is rebuilt when the environment changes.
+ */
+typedef struct ucs_config_parser_cache {
+    pthread_mutex_t                  lock;       /* Protects the cache */
+    uint64_t                         env_hash;   /* Environment in the index */
+    int                              env_valid;  /* Whether index is built */
+    khash_t(ucs_config_env_index)    env_index;  /* Variable name -> value */
+    ucs_list_link_t                  memo_list;  /* Memoized parse results */
+    volatile uint32_t                generation; /* Invalidates memo_list */
+} ucs_config_parser_cache_t;
+
 
 /* Process environment variables */
 extern char **environ;
@@ -58,6 +89,14 @@ static khash_t(ucs_config_env_vars) ucs_config_parser_env_vars = {0};
 static khash_t(ucs_config_map) ucs_config_file_vars            = {0};
 static pthread_mutex_t ucs_config_parser_env_vars_hash_lock    = PTHREAD_MUTEX_INITIALIZER;
 static char ucs_config_parser_negate                           = '^';
+static ucs_config_parser_cache_t ucs_config_parser_cache       = {
+    .lock       = PTHREAD_MUTEX_INITIALIZER,
+    .env_hash   = 0,
+    .env_valid  = 0,
+    .memo_list  = UCS_LIST_INITIALIZER(&ucs_config_parser_cache.memo_list,
+                                       &ucs_config_parser_cache.memo_list),
+    .generation = 0
+};
 
 
 const char *ucs_async_mode_names[] = {
@@ -68,6 +107,14 @@ const char *ucs_async_mode_names[] = {
     [UCS_ASYNC_MODE_LAST]            = NULL
 };
 
+const char *ucs_vma_query_names[] = {
+    [UCS_VMA_QUERY_AUTO]  = "auto",
+    [UCS_VMA_QUERY_IOCTL] = "ioctl",
+    [UCS_VMA_QUERY_CACHE] = "cache",
+    [UCS_VMA_QUERY_PARSE] = "parse",
+    [UCS_VMA_QUERY_LAST]  = NULL
+};
+
 UCS_CONFIG_DEFINE_ARRAY(string, sizeof(char*), UCS_CONFIG_TYPE_STRING);
 
 
@@ -1605,6 +1652,215 @@ static int ucs_config_parse_config_file_line(void *arg, const char *section,
     return 1;
 }
 
+static void ucs_config_parser_invalidate()
+{
+    ucs_atomic_add32(&ucs_config_parser_cache.generation, 1);
+}
+
+static uint64_t ucs_config_parser_environ_hash()
+{
+    uint64_t hash = (uintptr_t)environ;
+    const char *p;
+    char **envp;
+
+    /* Hash the string addresses as well, since the index points to them */
+    for (envp = environ; *envp != NULL; ++envp) {
+        hash = (hash * 31) + (uintptr_t)*envp;
+        for (p = *envp; *p != '\0'; ++p) {
+            hash = (hash * 31) + *p;
+        }
+    }
+
+    return hash;
+}
+
+static void ucs_config_parser_env_index_clear()
+{
+    const char *key;
+
+    kh_foreach_key(&ucs_config_parser_cache.env_index, key, {
+        ucs_free((void*)key);
+    })
+    kh_clear(ucs_config_env_index, &ucs_config_parser_cache.env_index);
+    ucs_config_parser_cache.env_valid = 0;
+}
+
+/* Called with the cache lock held */
+static uint64_t ucs_config_parser_env_index_update()
+{
+    uint64_t env_hash = ucs_config_parser_environ_hash();
+    const char *value;
+    khiter_t iter;
+    char **envp;
+    char *key;
+    int ret;
+
+    if (ucs_config_parser_cache.env_valid &&
+        (ucs_config_parser_cache.env_hash == env_hash)) {
+        return env_hash;
+    }
+
+    ucs_config_parser_env_index_clear();
+
+    for (envp = environ; *envp != NULL; ++envp) {
+        value = strchr(*envp, '=');
+        if (value == NULL) {
+            continue;
+        }
+
+        key = ucs_strndup(*envp, value - *envp, "config_env_index");
+        if (key == NULL) {
+            goto err;
+        }
+
+        iter = kh_put(ucs_config_env_index, &ucs_config_parser_cache.env_index,
+                      key, &ret);
+        if (ret == UCS_KH_PUT_FAILED) {
+            ucs_free(key);
+            goto err;
+        } else if (ret == UCS_KH_PUT_KEY_PRESENT) {
+            /* getenv() returns the first occurrence */
+            ucs_free(key);
+            continue;
+        }
+
+        kh_val(&ucs_config_parser_cache.env_index, iter) = value + 1;
+    }
+
+    ucs_config_parser_cache.env_hash  = env_hash;
+    ucs_config_parser_cache.env_valid = 1;
+    return env_hash;
+
+err:
+    ucs_debug("failed to build environment index, using getenv()");
+    ucs_config_parser_env_index_clear();
+    return env_hash;
+}
+
+static const char *ucs_config_parser_getenv(const char *name)
+{
+    khiter_t iter;
+
+    if (!ucs_config_parser_cache.env_valid) {
+        return getenv(name);
+    }
+
+    iter = kh_get(ucs_config_env_index, &ucs_config_parser_cache.env_index,
+                  name);
+    if (iter == kh_end(&ucs_config_parser_cache.env_index)) {
+        return NULL;
+    }
+
+    return kh_val(&ucs_config_parser_cache.env_index, iter);
+}
+
+static void ucs_config_parser_memo_free(ucs_config_parser_memo_t *memo)
+{
+    ucs_list_del(&memo->list);
+    ucs_config_parser_release_opts(memo->opts, memo->table);
+    ucs_free(memo->opts);
+    ucs_free(memo->env_prefix);
+    ucs_free(memo->table_prefix);
+    ucs_free(memo);
+}
+
+static int ucs_config_parser_prefix_equal(const char *prefix1,
+                                          const char *prefix2)
+{
+    if ((prefix1 == NULL) || (prefix2 == NULL)) {
+        return prefix1 == prefix2;
+    }
+
+    return !strcmp(prefix1, prefix2);
+}
+
+/* Called with the cache lock held */
+static ucs_config_parser_memo_t *
+ucs_config_parser_memo_find(const ucs_config_global_list_entry_t *entry,
+                            const char *env_prefix, int ignore_errors,
+                            uint64_t env_hash)
+{
+    ucs_config_parser_memo_t *memo;
+
+    ucs_list_for_each(memo, &ucs_config_parser_cache.memo_list, list) {
+        if ((memo->entry != entry) || (memo->table != entry->table) ||
+            (memo->ignore_errors != ignore_errors) ||
+            !ucs_config_parser_prefix_equal(memo->table_prefix,
+                                            entry->prefix) ||
+            strcmp(memo->env_prefix, env_prefix)) {
+            continue;
+        }
+
+        if ((memo->env_hash != env_hash) ||
+            (memo->generation != ucs_config_parser_cache.generation)) {
+            ucs_config_parser_memo_free(memo);
+            return NULL;
+        }
+
+        return memo;
+    }
+
+    return NULL;
+}
+
+/* Called with the cache lock held */
+static void
+ucs_config_parser_memo_add(const void *opts,
+                           const ucs_config_global_list_entry_t *entry,
+                           const char *env_prefix, int ignore_errors,
+                           uint64_t env_hash)
+{
+    ucs_config_parser_memo_t *memo;
+    ucs_status_t status;
+
+    memo = ucs_calloc(1, sizeof(*memo), "config_parser_memo");
+    if (memo == NULL) {
+        goto err;
+    }
+
+    memo->entry         = entry;
+    memo->table         = entry->table;
+    memo->ignore_errors = ignore_errors;
+    memo->env_hash      = env_hash;
+    memo->generation    = ucs_config_parser_cache.generation;
+    memo->env_prefix    = ucs_strdup(env_prefix, "config_parser_memo_prefix");
+    if (memo->env_prefix == NULL) {
+        goto err_free_memo;
+    }
+
+    if (entry->prefix != NULL) {
+        memo->table_prefix = ucs_strdup(entry->prefix,
+                                        "config_parser_memo_prefix");
+        if (memo->table_prefix == NULL) {
+            goto err_free_env_prefix;
+        }
+    }
+
+    memo->opts = ucs_calloc(1, entry->size, "config_parser_memo_opts");
+    if (memo->opts == NULL) {
+        goto err_free_table_prefix;
+    }
+
+    status = ucs_config_parser_clone_opts(opts, memo->opts, entry->table);
+    if (status != UCS_OK) {
+        goto err_free_opts;
+    }
+
+    ucs_list_add_head(&ucs_config_parser_cache.memo_list, &memo->list);
+    return;
+
+err_free_opts:
+    ucs_free(memo->opts);
+err_free_table_prefix:
+    ucs_free(memo->table_prefix);
+err_free_env_prefix:
+    ucs_free(memo->env_prefix);
+err_free_memo:
+    ucs_free(memo);
+err:
+    ucs_debug("failed to memoize configuration of '%s'", entry->name);
+}
+
 void ucs_config_parse_config_file(const char *dir_path, const char *file_name,
                                   int override)
 {
@@ -1626,6 +1882,7 @@ void ucs_config_parse_config_file(const char *dir_path, const char *file_name,
 
     parse_result = ini_parse_file(file, ucs_config_parse_config_file_line,
                                   &parse_arg);
+    ucs_config_parser_invalidate();
     if (parse_result != 0) {
         ucs_warn("failed to parse config file %s: %d", file_path, parse_result);
     }
@@ -1683,7 +1940,7 @@ ucs_config_apply_config_vars(void *opts, ucs_config_field_t *fields,
             strncpy(buf + prefix_len, field->name, sizeof(buf) - prefix_len - 1);
 
             /* Env variable has precedence over file config */
-            env_value = getenv(buf);
+            env_value = ucs_config_parser_getenv(buf);
             if (env_value == NULL) {
                 env_value = ucs_config_get_value_from_config_file(buf);
             }
@@ -1779,12 +2036,12 @@ void ucs_config_parse_config_files()
     ucs_config_parse_config_file(".", UCX_CONFIG_FILE_NAME, 1);
 }
 
-ucs_status_t
-ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
-                            const char *env_prefix, int ignore_errors)
+static ucs_status_t
+ucs_config_parser_parse_opts(void *opts,
+                             const ucs_config_global_list_entry_t *entry,
+                             const char *env_prefix, int ignore_errors)
 {
-    const char   *sub_prefix = NULL;
-    static ucs_init_once_t config_file_parse = UCS_INIT_ONCE_INITIALIZER;
+    const char *sub_prefix = NULL;
     ucs_status_t status;
 
     /* Set default values */
@@ -1793,14 +2050,9 @@ ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
         goto err;
     }
 
-    ucs_assert(env_prefix != NULL);
     status = ucs_config_parser_get_sub_prefix(env_prefix, &sub_prefix);
     if (status != UCS_OK) {
-        goto err;
-    }
-
-    UCS_INIT_ONCE(&config_file_parse) {
-        ucs_config_parse_config_files();
+        goto err_free;
     }
 
     /* Apply environment variables */
@@ -1819,7 +2071,6 @@ ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
         goto err_free;
     }
 
-    entry->flags |= UCS_CONFIG_TABLE_FLAG_LOADED;
     return UCS_OK;
 
 err_free:
@@ -1829,10 +2080,52 @@ err:
     return status;
 }
 
+ucs_status_t
+ucs_config_parser_fill_opts(void *opts, ucs_config_global_list_entry_t *entry,
+                            const char *env_prefix, int ignore_errors)
+{
+    static ucs_init_once_t config_file_parse = UCS_INIT_ONCE_INITIALIZER;
+    ucs_config_parser_memo_t *memo;
+    ucs_status_t status;
+    uint64_t env_hash;
+
+    ucs_assert(env_prefix != NULL);
+
+    UCS_INIT_ONCE(&config_file_parse) {
+        ucs_config_parse_config_files();
+    }
+
+    pthread_mutex_lock(&ucs_config_parser_cache.lock);
+
+    env_hash = ucs_config_parser_env_index_update();
+    memo     = ucs_config_parser_memo_find(entry, env_prefix, ignore_errors,
+                                           env_hash);
+    if (memo != NULL) {
+        status = ucs_config_parser_clone_opts(memo->opts, opts, entry->table);
+    } else {
+        status = ucs_config_parser_parse_opts(opts, entry, env_prefix,
+                                              ignore_errors);
+        if (status == UCS_OK) {
+            ucs_config_parser_memo_add(opts, entry, env_prefix, ignore_errors,
+                                       env_hash);
+        }
+    }
+
+    pthread_mutex_unlock(&ucs_config_parser_cache.lock);
+
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    entry->flags |= UCS_CONFIG_TABLE_FLAG_LOADED;
+    return UCS_OK;
+}
+
 ucs_status_t ucs_config_parser_set_value(void *opts, ucs_config_field_t *fields,
                                          const char *prefix, const char *name,
                                          const char *value)
 {
+    ucs_config_parser_invalidate();
     return ucs_config_parser_set_value_internal(opts, fields, name, value,
                                                 prefix, 1);
 }
@@ -2393,9 +2686,19 @@ void ucs_config_parser_get_env_vars(ucs_string_buffer_t *env_strb,
 
 void ucs_config_parser_cleanup()
 {
+    ucs_config_parser_memo_t *memo, *tmp_memo;
     const char *key;
     char *value;
 
+    ucs_list_for_each_safe(memo, tmp_memo, &ucs_config_parser_cache.memo_list,
+                           list) {
+        ucs_config_parser_memo_free(memo);
+    }
+
+    ucs_config_parser_env_index_clear();
+    kh_destroy_inplace(ucs_config_env_index,
+                       &ucs_config_parser_cache.env_index);
+
     kh_foreach_key(&ucs_config_parser_env_vars, key, {
         ucs_free((void*)key);
     })
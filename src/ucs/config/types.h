@@ -47,6 +47,21 @@ typedef enum {
 extern const char *ucs_async_mode_names[];
 
 
+/**
+ * Method for querying memory protection of virtual memory areas.
+ */
+typedef enum {
+    UCS_VMA_QUERY_AUTO,  /* Best available method */
+    UCS_VMA_QUERY_IOCTL, /* PROCMAP_QUERY ioctl on /proc/self/maps */
+    UCS_VMA_QUERY_CACHE, /* Sorted VMA table, invalidated by UCM events */
+    UCS_VMA_QUERY_PARSE, /* Parse /proc/self/maps on every query */
+    UCS_VMA_QUERY_LAST
+} ucs_vma_query_t;
+
+
+extern const char *ucs_vma_query_names[];
+
+
 /**
  * Ternary logic or Auto value.
  */
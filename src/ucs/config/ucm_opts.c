@@ -94,6 +94,15 @@ static ucs_config_field_t ucm_global_config_table[] = {
    ucs_offsetof(ucm_global_config_t, enable_dynamic_mmap_thresh),
    UCS_CONFIG_TYPE_BOOL},
 
+  {"MALLOC_HUGEPAGE_THRESH", "inf",
+   "Minimal size of a memory allocation which is mapped separately, aligned\n"
+   "to a huge page boundary and advised to use transparent huge pages. This\n"
+   "reduces TLB misses and the number of registration cache regions for large\n"
+   "communication buffers. The mmap threshold is capped by this value.\n"
+   "The value \"inf\" disables huge page backed allocations.",
+   ucs_offsetof(ucm_global_config_t, malloc_hugepage_thresh),
+   UCS_CONFIG_TYPE_MEMUNITS},
+
   {"DLOPEN_PROCESS_RPATH", "yes",
    "Process RPATH section of caller module during dynamic libraries opening.",
    ucs_offsetof(ucm_global_config_t, dlopen_process_rpath),
@@ -17,11 +17,14 @@
 void ucs_arbiter_init(ucs_arbiter_t *arbiter)
 {
     ucs_list_head_init(&arbiter->list);
+    ucs_list_head_init(&arbiter->prio_list);
 }
 
 void ucs_arbiter_group_init(ucs_arbiter_group_t *group)
 {
-    group->tail = NULL;
+    group->tail       = NULL;
+    group->prio_tail  = NULL;
+    group->prio_sched = 0;
     UCS_ARBITER_GROUP_GUARD_INIT(group);
 }
 
@@ -52,6 +55,16 @@ static inline void ucs_arbiter_elem_set_scheduled(ucs_arbiter_elem_t *elem,
     elem->group = group;
 }
 
+/* Select the list to put the group head on, according to whether the group has
+ * priority elements */
+static inline ucs_list_link_t *
+ucs_arbiter_group_sched_list(ucs_arbiter_group_t *group, ucs_list_link_t *list,
+                             ucs_list_link_t *prio_list)
+{
+    group->prio_sched = ucs_arbiter_group_has_prio(group);
+    return group->prio_sched ? prio_list : list;
+}
+
 void ucs_arbiter_group_push_elem_always(ucs_arbiter_group_t *group,
                                         ucs_arbiter_elem_t *elem)
 {
@@ -70,6 +83,26 @@ void ucs_arbiter_group_push_elem_always(ucs_arbiter_group_t *group,
     ucs_arbiter_elem_set_scheduled(elem, group);
 }
 
+void ucs_arbiter_group_push_prio_elem_always(ucs_arbiter_group_t *group,
+                                             ucs_arbiter_elem_t *elem)
+{
+    ucs_arbiter_elem_t *prio_tail = group->prio_tail;
+
+    if (prio_tail == NULL) {
+        /* first priority element goes to the head of the group */
+        ucs_arbiter_group_push_head_elem_always(group, elem);
+    } else {
+        ucs_arbiter_elem_set_scheduled(elem, group);
+        elem->next      = prio_tail->next;
+        prio_tail->next = elem;
+        if (prio_tail == group->tail) {
+            group->tail = elem;
+        }
+    }
+
+    group->prio_tail = elem;
+}
+
 void ucs_arbiter_group_push_head_elem_always(ucs_arbiter_group_t *group,
                                              ucs_arbiter_elem_t *elem)
 {
@@ -135,6 +168,11 @@ void ucs_arbiter_group_purge(ucs_arbiter_t *arbiter,
         result    = cb(arbiter, group, ptr, cb_arg);
 
         if (result == UCS_ARBITER_CB_RESULT_REMOVE_ELEM) {
+            if (ptr == group->prio_tail) {
+                /* all priority elements before it were kept */
+                group->prio_tail = (ptr == head) ? NULL : prev;
+            }
+
             if (ptr == head) {
                 head = next;
                 if (ptr == tail) {
@@ -202,15 +240,6 @@ int ucs_arbiter_group_is_scheduled(ucs_arbiter_group_t *group)
     return ucs_arbiter_group_head_is_scheduled(head);
 }
 
-static void
-ucs_arbiter_schedule_head_if_not_scheduled(ucs_arbiter_t *arbiter,
-                                           ucs_arbiter_elem_t *head)
-{
-    if (!ucs_arbiter_group_head_is_scheduled(head)) {
-        ucs_list_add_tail(&arbiter->list, &head->list);
-    }
-}
-
 void ucs_arbiter_group_schedule_nonempty(ucs_arbiter_t *arbiter,
                                          ucs_arbiter_group_t *group)
 {
@@ -221,7 +250,18 @@ void ucs_arbiter_group_schedule_nonempty(ucs_arbiter_t *arbiter,
     head = tail->next;
 
     ucs_assert(head != NULL);
-    ucs_arbiter_schedule_head_if_not_scheduled(arbiter, head);
+    if (!ucs_arbiter_group_head_is_scheduled(head)) {
+        ucs_list_add_tail(ucs_arbiter_group_sched_list(group, &arbiter->list,
+                                                       &arbiter->prio_list),
+                          &head->list);
+    } else if (ucs_arbiter_group_has_prio(group) && !group->prio_sched) {
+        /* promote the group to the priority list */
+        UCS_ARBITER_GROUP_ARBITER_CHECK(group, arbiter);
+        ucs_list_del(&head->list);
+        ucs_list_add_tail(&arbiter->prio_list, &head->list);
+        group->prio_sched = 1;
+    }
+
     UCS_ARBITER_GROUP_ARBITER_SET(group, arbiter);
 }
 
@@ -269,19 +309,24 @@ ucs_arbiter_group_head_replace(ucs_arbiter_group_t *group,
 void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
                                    ucs_arbiter_callback_t cb, void *cb_arg)
 {
-    ucs_arbiter_elem_t *group_head;
+    ucs_arbiter_elem_t *group_head, *prio_tail;
     ucs_arbiter_cb_result_t result;
     unsigned group_dispatch_count;
     ucs_arbiter_group_t *group;
     UCS_LIST_HEAD(resched_list);
+    UCS_LIST_HEAD(prio_resched_list);
+    ucs_list_link_t *sched_list;
     ucs_arbiter_elem_t dummy;
 
-    ucs_assert(!ucs_list_is_empty(&arbiter->list));
+    ucs_assert(!ucs_arbiter_is_empty(arbiter));
 
     ucs_arbiter_group_head_reset(&dummy);
 
     do {
-        group_head = ucs_list_extract_head(&arbiter->list, ucs_arbiter_elem_t,
+        /* groups with priority elements are dispatched first */
+        sched_list = ucs_list_is_empty(&arbiter->prio_list) ?
+                     &arbiter->list : &arbiter->prio_list;
+        group_head = ucs_list_extract_head(sched_list, ucs_arbiter_elem_t,
                                            list);
         ucs_assert(group_head != NULL);
 
@@ -315,6 +360,13 @@ void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
              */
             ucs_arbiter_group_head_replace(group, group_head, &dummy);
 
+            /* priority elements pushed by the dispatch callback must be added
+             * after the dummy element, since it's the group head now */
+            prio_tail = group->prio_tail;
+            if ((prio_tail == NULL) || (prio_tail == group_head)) {
+                group->prio_tail = &dummy;
+            }
+
             /* dispatch the element */
             ucs_trace_poll("dispatching arbiter element %p", group_head);
             UCS_ARBITER_GROUP_GUARD_ENTER(group);
@@ -326,6 +378,13 @@ void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
             /* recursive push to head (during dispatch) is not allowed */
             ucs_assert(group->tail->next == &dummy);
 
+            if (group->prio_tail == &dummy) {
+                /* no priority elements were pushed by the callback */
+                group->prio_tail = ((prio_tail == group_head) &&
+                                    (result != UCS_ARBITER_CB_RESULT_REMOVE_ELEM)) ?
+                                   group_head : NULL;
+            }
+
             /* element is not removed */
             if (ucs_unlikely(result != UCS_ARBITER_CB_RESULT_REMOVE_ELEM)) {
                 /* restore group pointer */
@@ -353,14 +412,23 @@ void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
 
                     if (result == UCS_ARBITER_CB_RESULT_NEXT_GROUP) {
                         /* add to arbiter tail */
-                        ucs_list_add_tail(&arbiter->list, &group_head->list);
+                        ucs_list_add_tail(ucs_arbiter_group_sched_list(
+                                                  group, &arbiter->list,
+                                                  &arbiter->prio_list),
+                                          &group_head->list);
                     } else if (result == UCS_ARBITER_CB_RESULT_RESCHED_GROUP) {
                         /* add to resched list */
-                        ucs_list_add_tail(&resched_list, &group_head->list);
+                        ucs_list_add_tail(ucs_arbiter_group_sched_list(
+                                                  group, &resched_list,
+                                                  &prio_resched_list),
+                                          &group_head->list);
                     } else if (result == UCS_ARBITER_CB_RESULT_STOP) {
                         /* exit the outmost loop and make sure that next dispatch()
                          * will continue from the current group */
-                        ucs_list_add_head(&arbiter->list, &group_head->list);
+                        ucs_list_add_head(ucs_arbiter_group_sched_list(
+                                                  group, &arbiter->list,
+                                                  &arbiter->prio_list),
+                                          &group_head->list);
                         goto out;
                     } else {
                         ucs_bug("unexpected return value from arbiter callback");
@@ -391,35 +459,33 @@ void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
                 break;
             } else if (group_dispatch_count >= per_group) {
                 /* add to arbiter tail and continue to next group */
-                ucs_list_add_tail(&arbiter->list, &group_head->list);
+                ucs_list_add_tail(ucs_arbiter_group_sched_list(
+                                          group, &arbiter->list,
+                                          &arbiter->prio_list),
+                                  &group_head->list);
                 break;
             }
 
             /* continue with new group head */
             ucs_arbiter_group_head_reset(group_head);
         }
-    } while (!ucs_list_is_empty(&arbiter->list));
+    } while (!ucs_arbiter_is_empty(arbiter));
 
 out:
     ucs_list_splice_tail(&arbiter->list, &resched_list);
+    ucs_list_splice_tail(&arbiter->prio_list, &prio_resched_list);
 }
 
-void ucs_arbiter_dump(ucs_arbiter_t *arbiter, FILE *stream)
+static void ucs_arbiter_dump_list(ucs_list_link_t *list, FILE *stream)
 {
     static const int max_groups = 100;
     ucs_arbiter_elem_t *group_head, *elem;
     int count;
 
-    fprintf(stream, "-------\n");
-    if (ucs_list_is_empty(&arbiter->list)) {
-        fprintf(stream, "(empty)\n");
-        goto out;
-    }
-
     count = 0;
-    ucs_list_for_each(group_head, &arbiter->list, list) {
+    ucs_list_for_each(group_head, list, list) {
         elem = group_head;
-        if (ucs_list_head(&arbiter->list, ucs_arbiter_elem_t, list) == group_head) {
+        if (ucs_list_head(list, ucs_arbiter_elem_t, list) == group_head) {
             fprintf(stream, "=> ");
         } else {
             fprintf(stream, " * ");
@@ -444,6 +510,23 @@ void ucs_arbiter_dump(ucs_arbiter_t *arbiter, FILE *stream)
             break;
         }
     }
+}
+
+void ucs_arbiter_dump(ucs_arbiter_t *arbiter, FILE *stream)
+{
+    fprintf(stream, "-------\n");
+    if (ucs_arbiter_is_empty(arbiter)) {
+        fprintf(stream, "(empty)\n");
+        goto out;
+    }
+
+    if (!ucs_list_is_empty(&arbiter->prio_list)) {
+        fprintf(stream, "priority:\n");
+        ucs_arbiter_dump_list(&arbiter->prio_list, stream);
+        fprintf(stream, "regular:\n");
+    }
+
+    ucs_arbiter_dump_list(&arbiter->list, stream);
 
 out:
     fprintf(stream, "-------\n");
@@ -33,6 +33,17 @@
  *  - all except last element point to the next element in same group, and the
  *    last one points to the first (next).
  *
+ * Priority elements:
+ *  An element can be pushed to a group as a priority element, for example a
+ * latency-sensitive control message which should not wait behind bulk data.
+ * Priority elements are kept in FIFO order at the beginning of the group, before
+ * all regular elements, and the group keeps a pointer to the last of them
+ * (prio_tail). A group which has priority elements is scheduled on a separate
+ * priority list of the arbiter, which is dispatched before the regular list.
+ * Since the element being dispatched is already at the head of its group, it
+ * may be followed by priority elements which were pushed by the dispatch
+ * callback, even if it is not a priority element itself.
+ *
  * Note:
  *  Every element holds 4 pointers. It could be done with 3 pointers, so that
  *  the pointer to the previous group is put instead of "next" pointer in the last
@@ -146,7 +157,9 @@ typedef ucs_arbiter_cb_result_t (*ucs_arbiter_callback_t)(ucs_arbiter_t *arbiter
  * Top-level arbiter.
  */
 struct ucs_arbiter {
-    ucs_list_link_t         list;
+    ucs_list_link_t         list;       /* Scheduled groups */
+    ucs_list_link_t         prio_list;  /* Scheduled groups which have
+                                           priority elements */
 };
 
 
@@ -155,6 +168,9 @@ struct ucs_arbiter {
  */
 struct ucs_arbiter_group {
     ucs_arbiter_elem_t      *tail;
+    ucs_arbiter_elem_t      *prio_tail; /* Last priority element, or NULL */
+    int                     prio_sched; /* Whether the group head was put on
+                                           the arbiter priority list */
     UCS_ARBITER_GROUP_GUARD_DEFINE;
     UCS_ARBITER_GROUP_ARBITER_DEFINE;
 };
@@ -213,6 +229,13 @@ void ucs_arbiter_group_push_elem_always(ucs_arbiter_group_t *group,
                                         ucs_arbiter_elem_t *elem);
 
 
+/**
+ * Add a new priority work element to a group - internal function
+ */
+void ucs_arbiter_group_push_prio_elem_always(ucs_arbiter_group_t *group,
+                                             ucs_arbiter_elem_t *elem);
+
+
 /**
  * Add a new work element to the head of a group - internal function
  */
@@ -264,7 +287,8 @@ void ucs_arbiter_dispatch_nonempty(ucs_arbiter_t *arbiter, unsigned per_group,
  */
 static inline int ucs_arbiter_is_empty(ucs_arbiter_t *arbiter)
 {
-    return ucs_list_is_empty(&arbiter->list);
+    return ucs_list_is_empty(&arbiter->list) &&
+           ucs_list_is_empty(&arbiter->prio_list);
 }
 
 
@@ -289,7 +313,8 @@ static inline int ucs_arbiter_group_is_empty(ucs_arbiter_group_t *group)
 
 /**
  * Schedule a group for arbitration. If the group is already there, the operation
- * will have no effect.
+ * will have no effect, unless the group has priority elements and was scheduled
+ * on the regular list, in which case it is moved to the priority list.
  *
  * @param [in]  arbiter  Arbiter object to schedule the group on.
  * @param [in]  group    Group to schedule.
@@ -347,6 +372,36 @@ ucs_arbiter_group_push_elem(ucs_arbiter_group_t *group,
 }
 
 
+/**
+ * Add a new priority work element to a group if it is not already there. The
+ * element is added after all priority elements already in the group, but before
+ * any regular element. If the group is scheduled, or scheduled later, it will
+ * be dispatched before groups which do not have priority elements.
+ *
+ * @param [in]  group    Group to add the element to.
+ * @param [in]  elem     Work element to add.
+ */
+static inline void
+ucs_arbiter_group_push_prio_elem(ucs_arbiter_group_t *group,
+                                 ucs_arbiter_elem_t *elem)
+{
+    if (ucs_arbiter_elem_is_scheduled(elem)) {
+        return;
+    }
+
+    ucs_arbiter_group_push_prio_elem_always(group, elem);
+}
+
+
+/**
+ * @return whether the group has priority elements.
+ */
+static inline int ucs_arbiter_group_has_prio(ucs_arbiter_group_t *group)
+{
+    return group->prio_tail != NULL;
+}
+
+
 /**
  * Add a new work element to the head of a group if it is not already there
  *
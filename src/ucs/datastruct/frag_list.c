@@ -12,6 +12,10 @@
 
 #include "frag_list.h"
 
+
+/* Minimal number of holes to index them in a tree */
+#define UCS_FRAG_LIST_TREE_THRESH 16
+
 #ifdef ENABLE_STATS
 
 static ucs_stats_class_t ucs_frag_list_stats_class = {
@@ -40,6 +44,7 @@ ucs_status_t ucs_frag_list_init(ucs_frag_list_sn_t initial_sn, ucs_frag_list_t *
     frag_list->elem_count = 0;
     frag_list->list_count = 0;
     frag_list->max_holes = max_holes;
+    frag_list->tree = NULL;
     ucs_queue_head_init(&frag_list->list);
     ucs_queue_head_init(&frag_list->ready_list);
 
@@ -56,11 +61,175 @@ void ucs_frag_list_cleanup(ucs_frag_list_t *frag_list)
 {
     ucs_assert(frag_list->elem_count == 0);
     ucs_assert(frag_list->list_count == 0);
+    ucs_assert(frag_list->tree == NULL);
     ucs_assert(ucs_queue_is_empty(&frag_list->list));
     ucs_assert(ucs_queue_is_empty(&frag_list->ready_list));
     UCS_STATS_NODE_FREE(frag_list->stats);
 }
 
+/*
+ * Top-down splay of the holes tree around sn. Returns the new tree root, which
+ * is the hole head with first_sn == sn if there is one, or otherwise the last
+ * hole head on the search path (either the predecessor or the successor of sn).
+ */
+static ucs_frag_list_elem_t *
+frag_list_tree_splay(ucs_frag_list_elem_t *t, ucs_frag_list_sn_t sn)
+{
+    ucs_frag_list_elem_t n, *l, *r, *y;
+
+    if (t == NULL) {
+        return NULL;
+    }
+
+    n.head.left = n.head.right = NULL;
+    l = r = &n;
+
+    for (;;) {
+        if (UCS_FRAG_LIST_SN_CMP(sn, <, t->head.first_sn)) {
+            if (t->head.left == NULL) {
+                break;
+            }
+            if (UCS_FRAG_LIST_SN_CMP(sn, <, t->head.left->head.first_sn)) {
+                /* rotate right */
+                y             = t->head.left;
+                t->head.left  = y->head.right;
+                y->head.right = t;
+                t             = y;
+                if (t->head.left == NULL) {
+                    break;
+                }
+            }
+            /* link right */
+            r->head.left = t;
+            r            = t;
+            t            = t->head.left;
+        } else if (UCS_FRAG_LIST_SN_CMP(sn, >, t->head.first_sn)) {
+            if (t->head.right == NULL) {
+                break;
+            }
+            if (UCS_FRAG_LIST_SN_CMP(sn, >, t->head.right->head.first_sn)) {
+                /* rotate left */
+                y             = t->head.right;
+                t->head.right = y->head.left;
+                y->head.left  = t;
+                t             = y;
+                if (t->head.right == NULL) {
+                    break;
+                }
+            }
+            /* link left */
+            l->head.right = t;
+            l             = t;
+            t             = t->head.right;
+        } else {
+            break;
+        }
+    }
+
+    /* assemble */
+    l->head.right = t->head.left;
+    r->head.left  = t->head.right;
+    t->head.left  = n.head.right;
+    t->head.right = n.head.left;
+    return t;
+}
+
+static void frag_list_tree_add(ucs_frag_list_t *frag_list,
+                               ucs_frag_list_elem_t *h)
+{
+    ucs_frag_list_elem_t *t;
+
+    if (frag_list->tree == NULL) {
+        return; /* holes are not indexed */
+    }
+
+    t = frag_list_tree_splay(frag_list->tree, h->head.first_sn);
+    if (t == NULL) {
+        h->head.left  = NULL;
+        h->head.right = NULL;
+    } else if (UCS_FRAG_LIST_SN_CMP(h->head.first_sn, <, t->head.first_sn)) {
+        h->head.left  = t->head.left;
+        h->head.right = t;
+        t->head.left  = NULL;
+    } else {
+        ucs_assert(UCS_FRAG_LIST_SN_CMP(h->head.first_sn, >, t->head.first_sn));
+        h->head.right = t->head.right;
+        h->head.left  = t;
+        t->head.right = NULL;
+    }
+
+    frag_list->tree = h;
+}
+
+static void frag_list_tree_del(ucs_frag_list_t *frag_list,
+                               ucs_frag_list_elem_t *h)
+{
+    ucs_frag_list_elem_t *t;
+
+    if (frag_list->tree == NULL) {
+        return;
+    }
+
+    t = frag_list_tree_splay(frag_list->tree, h->head.first_sn);
+    ucs_assert(t == h);
+
+    if (t->head.left == NULL) {
+        frag_list->tree = t->head.right;
+    } else {
+        /* all left keys are smaller, so the largest one becomes the root and
+         * has no right child */
+        frag_list->tree = frag_list_tree_splay(t->head.left, h->head.first_sn);
+        frag_list->tree->head.right = t->head.right;
+    }
+}
+
+/*
+ * Find the last hole head which has first_sn <= sn, or NULL if there is none.
+ * With few holes, walking the list is faster than maintaining the tree, so the
+ * holes are indexed only after their number exceeds a threshold, and until the
+ * list becomes empty. The tree is NULL when the holes are not indexed.
+ */
+static ucs_frag_list_elem_t *
+frag_list_tree_find(ucs_frag_list_t *frag_list, ucs_frag_list_sn_t sn)
+{
+    ucs_frag_list_elem_t *t, *h, *prevh;
+
+    if (frag_list->tree == NULL) {
+        prevh = NULL;
+        ucs_queue_for_each(h, &frag_list->list, list) {
+            if (UCS_FRAG_LIST_SN_CMP(h->head.first_sn, >, sn)) {
+                break;
+            }
+            prevh = h;
+        }
+
+        if (frag_list->list_count >= UCS_FRAG_LIST_TREE_THRESH) {
+            /* sorted insertion into a splay tree is O(1) amortized */
+            ucs_queue_for_each(h, &frag_list->list, list) {
+                h->head.left    = frag_list->tree;
+                h->head.right   = NULL;
+                frag_list->tree = h;
+            }
+        }
+
+        return prevh;
+    }
+
+    t = frag_list_tree_splay(frag_list->tree, sn);
+    frag_list->tree = t;
+    if ((t == NULL) || UCS_FRAG_LIST_SN_CMP(t->head.first_sn, <=, sn)) {
+        return t;
+    }
+
+    if (t->head.left == NULL) {
+        return NULL;
+    }
+
+    /* predecessor is the largest element of the left subtree */
+    t->head.left = frag_list_tree_splay(t->head.left, sn);
+    return t->head.left;
+}
+
 /*
  prevh--- h --- .. ---
           |
@@ -263,7 +432,7 @@ ucs_frag_list_ooo_type_t
 ucs_frag_list_insert_slow(ucs_frag_list_t *head, ucs_frag_list_elem_t *elem,
                           ucs_frag_list_sn_t sn)
 {
-    ucs_frag_list_elem_t *h, *prevh, *nexth;
+    ucs_frag_list_elem_t *h, *prevh;
 
     if (UCS_FRAG_LIST_SN_CMP(sn, ==, head->head_sn + 1)) {
         return ucs_frag_list_insert_head(head, elem, sn);
@@ -277,66 +446,67 @@ ucs_frag_list_insert_slow(ucs_frag_list_t *head, ucs_frag_list_elem_t *elem,
         return UCS_FRAG_LIST_INSERT_FAIL;
     }
 
-    prevh = NULL;
-    /* find right list to insert */
-    ucs_queue_for_each(h, &head->list, list) {
+    /* find the list which precedes sn, and the one which follows it */
+    prevh = frag_list_tree_find(head, sn);
+    if (prevh != NULL) {
+        h = ucs_queue_is_tail(&head->list, &prevh->list) ? NULL :
+            ucs_container_of(prevh->list.next, ucs_frag_list_elem_t, list);
+    } else if (!ucs_queue_is_empty(&head->list)) {
+        h = ucs_queue_head_elem_non_empty(&head->list, ucs_frag_list_elem_t,
+                                          list);
+    } else {
+        h = NULL;
+    }
+
+    if (prevh != NULL) {
         /* trying to insert duplicate. retransmission or packet duplication */
-        if (UCS_FRAG_LIST_SN_CMP(sn, >=, h->head.first_sn) &&
-            UCS_FRAG_LIST_SN_CMP(sn, <=,  h->head.last_sn)) {
+        if (UCS_FRAG_LIST_SN_CMP(sn, <=,  prevh->head.last_sn)) {
             return UCS_FRAG_LIST_INSERT_DUP;
         }
 
-        if (UCS_FRAG_LIST_SN_CMP(sn+1, ==, h->head.first_sn)) {
-            frag_list_replace_head(head, prevh, h, elem);
-            /* no need to check merge here. merge iff prev->last_sn+1==sn & sn+1 == h->first_sn
-             * the condition is handled in next if */
-            head->elem_count++;
-            return UCS_FRAG_LIST_INSERT_SLOW;
-        }
-
         /* todo: mark as likely */
-        if (UCS_FRAG_LIST_SN_CMP(h->head.last_sn + 1, ==, sn)) {
-            ucs_assertv(UCS_FRAG_LIST_SN_CMP(h->head.first_sn, <=, h->head.last_sn),
-                        "h=%p first_sn=%u last_sn=%u", h, h->head.first_sn,
-                        h->head.last_sn);
+        if (UCS_FRAG_LIST_SN_CMP(prevh->head.last_sn + 1, ==, sn)) {
+            ucs_assertv(UCS_FRAG_LIST_SN_CMP(prevh->head.first_sn, <=,
+                                             prevh->head.last_sn),
+                        "h=%p first_sn=%u last_sn=%u", prevh,
+                        prevh->head.first_sn, prevh->head.last_sn);
             /* add tail, check merge with next list */
-            frag_list_add_tail(h, elem);
-            nexth = ucs_container_of(h->list.next, ucs_frag_list_elem_t, list);
-            if (!ucs_queue_is_tail(&head->list, &h->list) &&
-                (nexth->head.first_sn == (sn + 1))) {
-                frag_list_merge_heads(head, h, nexth);
+            frag_list_add_tail(prevh, elem);
+            if ((h != NULL) && (h->head.first_sn == (ucs_frag_list_sn_t)(sn + 1))) {
+                frag_list_tree_del(head, h);
+                frag_list_merge_heads(head, prevh, h);
                 head->list_count--;
             }
             head->elem_count++;
             return UCS_FRAG_LIST_INSERT_SLOW;
         }
-
-        if (UCS_FRAG_LIST_SN_CMP(sn, <, h->head.first_sn)) {
-            /* new hole, see above comment on merge */
-            if (prevh) {
-                ucs_assert(UCS_FRAG_LIST_SN_CMP(prevh->head.last_sn+1, <, sn));
-            }
-            UCS_STATS_UPDATE_COUNTER(head->stats, UCS_FRAG_LIST_STAT_GAP_LEN,
-                                     prevh ? sn-prevh->head.last_sn : sn-head->head_sn);
-            UCS_STATS_UPDATE_COUNTER(head->stats, UCS_FRAG_LIST_STAT_GAPS, 1);
-            frag_list_insert_head(head, prevh, h, elem, sn);
-            head->elem_count++;
-            head->list_count++;
-            return UCS_FRAG_LIST_INSERT_SLOW;
-        }
-
-        /* if we got here following must hold */
-        ucs_assert(UCS_FRAG_LIST_SN_CMP(h->head.last_sn+1, <, sn));
-        prevh = h;
     }
 
-    frag_list_insert_tail(head, elem, sn);
+    if ((h != NULL) && UCS_FRAG_LIST_SN_CMP(sn+1, ==, h->head.first_sn)) {
+        frag_list_tree_del(head, h);
+        frag_list_replace_head(head, prevh, h, elem);
+        frag_list_tree_add(head, elem);
+        /* no need to check merge here. merge iff prev->last_sn+1==sn & sn+1 == h->first_sn
+         * the condition is handled above */
+        head->elem_count++;
+        return UCS_FRAG_LIST_INSERT_SLOW;
+    }
 
-    head->elem_count++;
-    head->list_count++;
+    /* new hole, see above comment on merge */
+    if (prevh) {
+        ucs_assert(UCS_FRAG_LIST_SN_CMP(prevh->head.last_sn+1, <, sn));
+    }
     UCS_STATS_UPDATE_COUNTER(head->stats, UCS_FRAG_LIST_STAT_GAP_LEN,
-                             sn-head->head_sn);
+                             prevh ? sn-prevh->head.last_sn : sn-head->head_sn);
     UCS_STATS_UPDATE_COUNTER(head->stats, UCS_FRAG_LIST_STAT_GAPS, 1);
+    if (h != NULL) {
+        frag_list_insert_head(head, prevh, h, elem, sn);
+    } else {
+        frag_list_insert_tail(head, elem, sn);
+    }
+    frag_list_tree_add(head, elem);
+    head->elem_count++;
+    head->list_count++;
     return UCS_FRAG_LIST_INSERT_SLOW;
 }
 
@@ -369,6 +539,7 @@ ucs_frag_list_elem_t *ucs_frag_list_pull_slow(ucs_frag_list_t *head)
     head->list_count--;
 
     h = ucs_queue_pull_elem_non_empty(&head->list, ucs_frag_list_elem_t, list);
+    frag_list_tree_del(head, h);
     ucs_queue_splice(&head->ready_list, &h->head.list);
     return h;
 }
@@ -409,4 +580,5 @@ void ucs_frag_list_dump(ucs_frag_list_t *head, int how)
 
     ucs_assert(head->elem_count == elem_count);
     ucs_assert(head->list_count == list_count);
+    ucs_assert((head->tree == NULL) || (list_count != 0));
 }
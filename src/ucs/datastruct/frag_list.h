@@ -22,15 +22,13 @@
  * Complexity:
  *  - O(1) for getting head element
  *  - O(Nelems) for memory, with the hard bound of sendwindowsize. In order insertion uses no memory.
- *  - O(k) insertion, where k is number of holes. Number of holes is expected to be
+ *  - O(log(k)) insertion, where k is number of holes. Number of holes is expected to be
  *  something like SendWindowSize/BurstPacketSize. With win 1024 and burst 16 we
- *  get to 64 holes. In reality the number should be much less because:
- *  - each route send 'bursts' in order
- *  - it takes roughly the same time for each route
- *  - number of routes (burst generatos is expected to be small)
- *
- *  so in the end number of holes is proportional to number of routes and time difference
- *  between alternative paths. Better math is welcome :P
+ *  get to 64 holes. Under heavy reordering (for example, multi-path) the number
+ *  of holes may be much larger, so the elemlist heads are also kept in a
+ *  splay tree ordered by first_sn, which is used to find the insert position
+ *  instead of walking the list of holes. The insertion is amortized O(log(k)),
+ *  and close to O(1) when consecutive insertions hit the same holes.
  *
  *  Organization
  *
@@ -42,6 +40,11 @@
  *
  *   elemlists and ready list are sorted and continuos - no holes
  *   ready list contains elements that can be easily pulled: head->sn = read_list.last_sn
+ *
+ *   The elemlist heads are linked both in the "list" queue, which is used to
+ *   pull them in order, and in the "tree", which is used to look them up.
+ *   Sequence numbers in the tree are compared with circular arithmetic, so all
+ *   the elements must be within half of the sequence number space.
  */
 
 /* Out-of-order handling type */
@@ -71,9 +74,11 @@ typedef uint16_t   ucs_frag_list_sn_t;
 #define UCS_FRAG_LIST_NEXT_SN(sn) ((ucs_frag_list_sn_t)((sn)+1))
 /* part of skb */
 typedef struct ucs_frag_list_head {
-    ucs_queue_head_t       list;
-    ucs_frag_list_sn_t first_sn;
-    ucs_frag_list_sn_t last_sn;
+    ucs_queue_head_t            list;
+    struct ucs_frag_list_elem_t *left;   /* Holes tree links, valid only */
+    struct ucs_frag_list_elem_t *right;  /* for elemlist heads */
+    ucs_frag_list_sn_t          first_sn;
+    ucs_frag_list_sn_t          last_sn;
 } ucs_frag_list_head_t;
 
 typedef struct ucs_frag_list_elem_t {
@@ -85,6 +90,7 @@ typedef struct ucs_frag_list_elem_t {
 /* part of connection */
 typedef struct ucs_frag_list {
     ucs_queue_head_t       list;
+    ucs_frag_list_elem_t   *tree;        /* elemlist heads, ordered by first_sn */
     ucs_queue_head_t       ready_list;
     ucs_frag_list_sn_t     head_sn;
     unsigned               elem_count;   /* total number of list elements */
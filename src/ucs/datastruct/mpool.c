@@ -70,6 +70,7 @@ void ucs_mpool_params_reset(ucs_mpool_params_t *params)
     params->grow_factor     = 1.0;
     params->ops             = NULL;
     params->name            = "";
+    params->numa_node       = UCS_NUMA_NODE_UNDEFINED;
 }
 
 static size_t ucs_mpool_chunk_size(ucs_mpool_t *mp, unsigned num_elems)
@@ -111,6 +112,7 @@ ucs_status_t ucs_mpool_init(const ucs_mpool_params_t *params, ucs_mpool_t *mp)
     mp->data->align_offset    = sizeof(ucs_mpool_elem_t) + params->align_offset;
     mp->data->elems_per_chunk = params->elems_per_chunk;
     mp->data->malloc_safe     = params->malloc_safe;
+    mp->data->numa_node       = params->numa_node;
     mp->data->quota           = params->max_elems;
     mp->data->tail            = NULL;
     mp->data->chunks          = NULL;
@@ -248,6 +250,8 @@ unsigned ucs_mpool_num_elems_per_chunk(ucs_mpool_t *mp,
 void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
 {
     ucs_mpool_data_t *data = mp->data;
+    int numa_prefer        = 0;
+    ucs_numa_policy_t numa_policy;
     size_t chunk_size;
     ucs_mpool_chunk_t *chunk;
     ucs_mpool_elem_t *elem;
@@ -263,7 +267,20 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
     allocated_num_elems = ucs_min(data->quota, num_elems);
     chunk_size          = ucs_mpool_chunk_size(mp, allocated_num_elems);
     chunk_size          = ucs_min(chunk_size, data->max_chunk_size);
+
+    /* Pages populated by chunk_alloc, e.g. when the chunk is registered,
+     * follow the policy of the calling thread */
+    if (data->numa_node != UCS_NUMA_NODE_UNDEFINED) {
+        numa_prefer = (ucs_numa_policy_prefer(data->numa_node,
+                                              &numa_policy) == UCS_OK);
+    }
+
     status = data->ops->chunk_alloc(mp, &chunk_size, &ptr);
+
+    if (numa_prefer) {
+        ucs_numa_policy_restore(&numa_policy);
+    }
+
     if (status != UCS_OK) {
         if (!data->malloc_safe) {
             ucs_error("Failed to allocate memory pool (name=%s) chunk: %s",
@@ -272,6 +289,10 @@ void ucs_mpool_grow(ucs_mpool_t *mp, unsigned num_elems)
         return;
     }
 
+    if (data->numa_node != UCS_NUMA_NODE_UNDEFINED) {
+        (void)ucs_numa_bind(ptr, chunk_size, data->numa_node);
+    }
+
     /* Calculate padding, and update element count according to allocated size */
     chunk            = ptr;
     chunk->elems     = ucs_mpool_chunk_elems(mp, chunk);
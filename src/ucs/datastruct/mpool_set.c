@@ -143,6 +143,17 @@ void ucs_mpool_set_cleanup(ucs_mpool_set_t *mp_set, int leak_check)
                                  leak_check);
 }
 
+void ucs_mpool_set_numa_bind(ucs_mpool_set_t *mp_set,
+                             ucs_numa_node_t numa_node)
+{
+    ucs_mpool_t *mpools = mp_set->data;
+    int i;
+
+    for (i = 0; i < ucs_popcount(mp_set->bitmap); ++i) {
+        mpools[i].data->numa_node = numa_node;
+    }
+}
+
 void *ucs_mpool_set_priv(ucs_mpool_set_t *mp_set)
 {
     return (ucs_mpool_t*)mp_set->data + ucs_popcount(mp_set->bitmap);
@@ -93,6 +93,17 @@ ucs_mpool_set_init(ucs_mpool_set_t *mp_set, size_t *sizes, unsigned sizes_count,
 void ucs_mpool_set_cleanup(ucs_mpool_set_t *mp_set, int leak_check);
 
 
+/**
+ * Allocate new chunks of all memory pools in the set on a given NUMA node.
+ *
+ * @param mp_set           Memory pool set structure.
+ * @param numa_node        NUMA node, or UCS_NUMA_NODE_UNDEFINED to follow the
+ *                         default memory policy.
+ */
+void ucs_mpool_set_numa_bind(ucs_mpool_set_t *mp_set,
+                             ucs_numa_node_t numa_node);
+
+
 /**
  * @param mp_set           Memory pool set structure.
  *
@@ -10,82 +10,148 @@
 
 #include "ptr_map.inl"
 
+#include <ucs/debug/memtrack_int.h>
+#include <string.h>
 
-static void ucs_ptr_hash_destroy(ucs_ptr_hash_t *ptr_hash)
+
+/* Initial number of slots */
+#define UCS_PTR_MAP_INIT_CAPACITY 64
+
+
+static void
+ucs_ptr_map_slots_init(ucs_ptr_map_t *map, ucs_ptr_map_slot_t *slots,
+                       uint32_t first_index, uint32_t last_index)
 {
-    size_t size = kh_size(ptr_hash);
-    if (size != 0) {
-        ucs_warn("ptr hash %p contains %zd elements on destroy", ptr_hash,
-                 size);
+    uint32_t index;
+
+    /* Link the new slots to the free list, so lower indexes are used first */
+    for (index = last_index; index > first_index; --index) {
+        slots[index - 1].ptr        = NULL;
+        slots[index - 1].generation = 0;
+        slots[index - 1].next_free  = map->free_head;
+        map->free_head              = index - 1;
     }
-    kh_destroy_inplace(ucs_ptr_map_impl, ptr_hash);
 }
 
-static ucs_status_t ucs_ptr_safe_hash_init(ucs_ptr_safe_hash_t *safe_hash)
+ucs_status_t ucs_ptr_map_grow(ucs_ptr_map_t *map, int is_put_thread_safe,
+                              ucs_ptr_map_safe_t *safe)
 {
-    kh_init_inplace(ucs_ptr_map_impl, &safe_hash->hash);
-    return ucs_spinlock_init(&safe_hash->lock, 0);
-}
+    uint32_t old_capacity = map->capacity;
+    uint32_t new_capacity;
+    ucs_ptr_map_slot_t *slots;
+
+    if (old_capacity == 0) {
+        new_capacity = UCS_PTR_MAP_INIT_CAPACITY;
+    } else if (old_capacity <= (UCS_MASK(31) / 2)) {
+        new_capacity = old_capacity * 2;
+    } else {
+        ucs_error("ptr map %p reached the maximal size of %u elements", map,
+                  old_capacity);
+        return UCS_ERR_EXCEEDS_LIMIT;
+    }
 
-static void ucs_ptr_safe_hash_destroy(ucs_ptr_safe_hash_t *safe_hash)
-{
-    ucs_ptr_hash_destroy(&safe_hash->hash);
-    ucs_spinlock_destroy(&safe_hash->lock);
+    if (!is_put_thread_safe) {
+        slots = ucs_realloc(map->slots, sizeof(*slots) * new_capacity,
+                            "ptr_map_slots");
+        if (slots == NULL) {
+            return UCS_ERR_NO_MEMORY;
+        }
+
+        ucs_ptr_map_slots_init(map, slots, old_capacity, new_capacity);
+        map->slots    = slots;
+        map->capacity = new_capacity;
+        return UCS_OK;
+    }
+
+    /* Concurrent lookups may still read the old array, so it is released
+     * only when the map is destroyed. Since the capacity is doubled every
+     * time, the retired arrays take less memory than the current one. */
+    ucs_assert_always(safe->num_retired < UCS_PTR_MAP_MAX_RETIRED);
+    slots = ucs_malloc(sizeof(*slots) * new_capacity, "ptr_map_slots");
+    if (slots == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    if (old_capacity != 0) {
+        memcpy(slots, map->slots, sizeof(*slots) * old_capacity);
+        safe->retired[safe->num_retired++] = map->slots;
+    }
+
+    ucs_ptr_map_slots_init(map, slots, old_capacity, new_capacity);
+    map->slots = slots;
+    /* Publish the slots array before the capacity which allows to use it */
+    ucs_memory_cpu_store_fence();
+    map->capacity = new_capacity;
+    return UCS_OK;
 }
 
-ucs_status_t ucs_ptr_safe_hash_get(ucs_ptr_map_t *map, ucs_ptr_map_key_t key,
-                                   int extract, void **ptr_p,
-                                   ucs_ptr_safe_hash_t *safe_hash)
+ucs_status_t ucs_ptr_map_safe_put(ucs_ptr_map_t *map, void *ptr,
+                                  ucs_ptr_map_key_t *key,
+                                  ucs_ptr_map_safe_t *safe)
 {
     ucs_status_t status;
 
-    ucs_spin_lock(&safe_hash->lock);
-    status = ucs_ptr_hash_get(&safe_hash->hash, key, 1, ptr_p);
-    ucs_spin_unlock(&safe_hash->lock);
-
-    if ((status == UCS_OK) && !extract) {
-        ucs_ptr_hash_put(&map->hash, key, *ptr_p);
-    }
+    ucs_spin_lock(&safe->lock);
+    status = ucs_ptr_map_slot_put(map, ptr, key, 1, safe);
+    ucs_spin_unlock(&safe->lock);
 
     return status;
 }
 
-ucs_status_t ucs_ptr_safe_hash_put(ucs_ptr_map_t *map, void *ptr,
-                                   ucs_ptr_map_key_t *key,
-                                   ucs_ptr_safe_hash_t *safe_hash)
+ucs_status_t ucs_ptr_map_safe_del(ucs_ptr_map_t *map, ucs_ptr_map_key_t key,
+                                  ucs_ptr_map_safe_t *safe)
 {
+    ucs_ptr_map_slot_t *slot;
     ucs_status_t status;
 
-    ucs_spin_lock(&safe_hash->lock);
-    *key   = ucs_ptr_map_create_key(map);
-    status = ucs_ptr_hash_put(&safe_hash->hash, *key, ptr);
-    ucs_spin_unlock(&safe_hash->lock);
+    ucs_spin_lock(&safe->lock);
+    /* The slots array could be replaced by a concurrent put */
+    slot = ucs_ptr_map_slot_find(map, key, 1);
+    if (slot != NULL) {
+        ucs_ptr_map_slot_release(map, slot);
+        status = UCS_OK;
+    } else {
+        status = UCS_ERR_NO_ELEM;
+    }
+    ucs_spin_unlock(&safe->lock);
 
     return status;
 }
 
 ucs_status_t ucs_ptr_map_init(ucs_ptr_map_t *map, int is_put_thread_safe,
-                              ucs_ptr_safe_hash_t *safe_hash)
+                              ucs_ptr_map_safe_t *safe)
 {
-    ucs_status_t status = UCS_OK;
-
     UCS_STATIC_ASSERT(!ucs_ptr_map_key_indirect(UCS_PTR_MAP_KEY_INVALID));
-    map->next_id = 0;
-    kh_init_inplace(ucs_ptr_map_impl, &map->hash);
 
-    if (is_put_thread_safe) {
-        status = ucs_ptr_safe_hash_init(safe_hash);
+    map->slots     = NULL;
+    map->capacity  = 0;
+    map->count     = 0;
+    map->free_head = UCS_PTR_MAP_SLOT_NONE;
+
+    if (!is_put_thread_safe) {
+        return UCS_OK;
     }
 
-    return status;
+    safe->num_retired = 0;
+    return ucs_spinlock_init(&safe->lock, 0);
 }
 
 void ucs_ptr_map_destroy(ucs_ptr_map_t *map, int is_put_thread_safe,
-                         ucs_ptr_safe_hash_t *safe_hash)
+                         ucs_ptr_map_safe_t *safe)
 {
-    ucs_ptr_hash_destroy(&map->hash);
+    unsigned i;
+
+    if (map->count != 0) {
+        ucs_warn("ptr map %p contains %u elements on destroy", map,
+                 map->count);
+    }
+
+    ucs_free(map->slots);
 
     if (is_put_thread_safe) {
-        ucs_ptr_safe_hash_destroy(safe_hash);
+        for (i = 0; i < safe->num_retired; ++i) {
+            ucs_free(safe->retired[i]);
+        }
+        ucs_spinlock_destroy(&safe->lock);
     }
 }
@@ -7,8 +7,6 @@
 #ifndef UCS_PTR_MAP_H_
 #define UCS_PTR_MAP_H_
 
-#include "khash.h"
-
 #include <ucs/sys/compiler.h>
 #include <ucs/type/spinlock.h>
 #include <ucs/type/status.h>
@@ -36,22 +34,38 @@ BEGIN_C_DECLS
 typedef uintptr_t ucs_ptr_map_key_t;
 
 
-KHASH_TYPE(ucs_ptr_map_impl, ucs_ptr_map_key_t, void*);
-typedef khash_t(ucs_ptr_map_impl) ucs_ptr_hash_t;
+/**
+ * Maximal number of slot arrays which are replaced by a larger array, and
+ * released only when the map is destroyed.
+ */
+#define UCS_PTR_MAP_MAX_RETIRED         32
+
+
+/**
+ * Slot which holds an object pointer, referenced by an indirect key.
+ */
+typedef struct ucs_ptr_map_slot {
+    void     *ptr; /**< Object pointer. */
+    uint32_t generation; /**< Incremented on every put and delete, so it is
+                              odd if the slot is used. */
+    uint32_t next_free; /**< Next slot in the free list. */
+} ucs_ptr_map_slot_t;
 
 
 typedef struct ucs_ptr_map {
-    uint64_t       next_id; /**< Generator of unique keys per map. */
-    ucs_ptr_hash_t hash; /**< Hash table to store indirect key to pointer
-                              associations. */
+    ucs_ptr_map_slot_t *slots; /**< Array of slots, indexed by the key. */
+    uint32_t           capacity; /**< Number of slots in the array. */
+    uint32_t           count; /**< Number of used slots. */
+    uint32_t           free_head; /**< First slot in the free list. */
 } ucs_ptr_map_t;
 
 
-typedef struct ucs_ptr_safe_hash {
-    ucs_ptr_hash_t hash; /**< Hash table to store indirect key to pointer
-                              associations. */
-    ucs_spinlock_t lock; /**< Spin lock to synchronize access to hash table. */
-} ucs_ptr_safe_hash_t;
+typedef struct ucs_ptr_map_safe {
+    ucs_spinlock_t     lock; /**< Spin lock to synchronize put and delete. */
+    unsigned           num_retired; /**< Number of retired slot arrays. */
+    ucs_ptr_map_slot_t *retired[UCS_PTR_MAP_MAX_RETIRED]; /**< Slot arrays
+                                    which could still be used by lookups. */
+} ucs_ptr_map_safe_t;
 
 
 /**
@@ -66,11 +80,15 @@ typedef struct ucs_ptr_safe_hash {
  *
  * @note Using UCS_PTR_MAP_GET and UCS_PTR_MAP_DEL with themselves and among
  *       themselves is not thread safe regardless of @a _is_put_thread_safe.
+ *
+ * Indirect keys encode the index of a slot in an array and the generation of
+ * the slot, so a lookup does not need hashing, and a key of a removed object
+ * is detected even if its slot was reused.
  */
 #define UCS_PTR_MAP_TYPE(_name, _is_put_thread_safe) \
     typedef struct { \
-        ucs_ptr_map_t       ptr_map; \
-        ucs_ptr_safe_hash_t safe[_is_put_thread_safe]; \
+        ucs_ptr_map_t      ptr_map; \
+        ucs_ptr_map_safe_t safe[_is_put_thread_safe]; \
     } UCS_PTR_MAP_T(_name);
 
 
@@ -79,21 +97,25 @@ typedef struct ucs_ptr_safe_hash {
 
 /* Internal helper function */
 ucs_status_t ucs_ptr_map_init(ucs_ptr_map_t *map, int is_put_thread_safe,
-                              ucs_ptr_safe_hash_t *safe_hash);
+                              ucs_ptr_map_safe_t *safe);
 
 
 void ucs_ptr_map_destroy(ucs_ptr_map_t *map, int is_put_thread_safe,
-                         ucs_ptr_safe_hash_t *safe_hash);
+                         ucs_ptr_map_safe_t *safe);
+
+
+ucs_status_t ucs_ptr_map_grow(ucs_ptr_map_t *map, int is_put_thread_safe,
+                              ucs_ptr_map_safe_t *safe);
 
 
 ucs_status_t
-ucs_ptr_safe_hash_put(ucs_ptr_map_t *map, void *ptr, ucs_ptr_map_key_t *key,
-                      ucs_ptr_safe_hash_t *safe_hash);
+ucs_ptr_map_safe_put(ucs_ptr_map_t *map, void *ptr, ucs_ptr_map_key_t *key,
+                     ucs_ptr_map_safe_t *safe);
 
 
 ucs_status_t
-ucs_ptr_safe_hash_get(ucs_ptr_map_t *map, ucs_ptr_map_key_t key, int extract,
-                      void **ptr_p, ucs_ptr_safe_hash_t *safe_hash);
+ucs_ptr_map_safe_del(ucs_ptr_map_t *map, ucs_ptr_map_key_t key,
+                     ucs_ptr_map_safe_t *safe);
 
 END_C_DECLS
 
@@ -9,6 +9,7 @@
 
 #include "ptr_map.h"
 
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/log.h>
 
 BEGIN_C_DECLS
@@ -30,56 +31,112 @@ BEGIN_C_DECLS
 #define ucs_ptr_map_key_indirect(_key) ((_key) & UCS_PTR_MAP_KEY_INDIRECT_FLAG)
 
 
-KHASH_IMPL(ucs_ptr_map_impl, ucs_ptr_map_key_t, void*, 1,
-           kh_int64_hash_func, kh_int64_hash_equal);
+/**
+ * Slot index which terminates the free list.
+ */
+#define UCS_PTR_MAP_SLOT_NONE           UINT32_MAX
+
+
+/**
+ * Indirect key layout: the flag in bit 0, the slot index in bits 1..31, and
+ * the slot generation in bits 32..63.
+ */
+#define UCS_PTR_MAP_KEY_INDEX_SHIFT      1
+#define UCS_PTR_MAP_KEY_GENERATION_SHIFT 32
+
 
 static UCS_F_ALWAYS_INLINE ucs_ptr_map_key_t
-ucs_ptr_map_create_key(ucs_ptr_map_t *map)
+ucs_ptr_map_key_create(uint32_t index, uint32_t generation)
 {
-    return (map->next_id += UCS_PTR_MAP_KEY_MIN_ALIGN) |
-            UCS_PTR_MAP_KEY_INDIRECT_FLAG;
+    return ((ucs_ptr_map_key_t)generation << UCS_PTR_MAP_KEY_GENERATION_SHIFT) |
+           ((ucs_ptr_map_key_t)index << UCS_PTR_MAP_KEY_INDEX_SHIFT) |
+           UCS_PTR_MAP_KEY_INDIRECT_FLAG;
 }
 
-static UCS_F_ALWAYS_INLINE ucs_status_t
-ucs_ptr_hash_put(ucs_ptr_hash_t *hash, ucs_ptr_map_key_t key, void *ptr)
+static UCS_F_ALWAYS_INLINE uint32_t
+ucs_ptr_map_key_index(ucs_ptr_map_key_t key)
 {
-    khiter_t iter;
-    int ret;
-
-    iter = kh_put(ucs_ptr_map_impl, hash, key, &ret);
-    if (ucs_unlikely(ret == UCS_KH_PUT_FAILED)) {
-        return UCS_ERR_NO_MEMORY;
-    } else if (ucs_unlikely(ret == UCS_KH_PUT_KEY_PRESENT)) {
-        return UCS_ERR_ALREADY_EXISTS;
+    return (uint32_t)key >> UCS_PTR_MAP_KEY_INDEX_SHIFT;
+}
+
+static UCS_F_ALWAYS_INLINE uint32_t
+ucs_ptr_map_key_generation(ucs_ptr_map_key_t key)
+{
+    return key >> UCS_PTR_MAP_KEY_GENERATION_SHIFT;
+}
+
+/**
+ * Find the used slot of an indirect key, or return NULL if the key is not
+ * valid anymore.
+ */
+static UCS_F_ALWAYS_INLINE ucs_ptr_map_slot_t *
+ucs_ptr_map_slot_find(const ucs_ptr_map_t *map, ucs_ptr_map_key_t key,
+                      int is_put_thread_safe)
+{
+    uint32_t index = ucs_ptr_map_key_index(key);
+    ucs_ptr_map_slot_t *slot;
+
+    if (ucs_unlikely(index >= map->capacity)) {
+        return NULL;
     }
 
-    kh_value(hash, iter) = ptr;
-    return UCS_OK;
+    if (is_put_thread_safe) {
+        /* Pairs with the store fence in ucs_ptr_map_grow(): if the new
+         * capacity is seen, then the new slots array is seen as well */
+        ucs_memory_cpu_load_fence();
+    }
+
+    slot = &map->slots[index];
+    if (ucs_unlikely(slot->generation != ucs_ptr_map_key_generation(key))) {
+        return NULL;
+    }
+
+    return slot;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
-ucs_ptr_hash_get(ucs_ptr_hash_t *hash, ucs_ptr_map_key_t key, int extract,
-                 void **ptr_p)
+ucs_ptr_map_slot_put(ucs_ptr_map_t *map, void *ptr, ucs_ptr_map_key_t *key,
+                     int is_put_thread_safe, ucs_ptr_map_safe_t *safe)
 {
-    khiter_t iter;
+    ucs_ptr_map_slot_t *slot;
+    ucs_status_t status;
+    uint32_t index;
 
-    iter = kh_get(ucs_ptr_map_impl, hash, key);
-    if (ucs_unlikely(iter == kh_end(hash))) {
-        *ptr_p = NULL; /* To suppress compiler warning */
-        return UCS_ERR_NO_ELEM;
+    if (ucs_unlikely(map->free_head == UCS_PTR_MAP_SLOT_NONE)) {
+        status = ucs_ptr_map_grow(map, is_put_thread_safe, safe);
+        if (status != UCS_OK) {
+            return status;
+        }
     }
 
-    *ptr_p = kh_value(hash, iter);
-    if (extract) {
-        kh_del(ucs_ptr_map_impl, hash, iter);
-    }
+    index          = map->free_head;
+    slot           = &map->slots[index];
+    map->free_head = slot->next_free;
+    slot->ptr      = ptr;
+    ++slot->generation;
+    ++map->count;
+
+    ucs_assert(slot->generation & 1);
+    *key = ucs_ptr_map_key_create(index, slot->generation);
     return UCS_OK;
 }
 
+static UCS_F_ALWAYS_INLINE void
+ucs_ptr_map_slot_release(ucs_ptr_map_t *map, ucs_ptr_map_slot_t *slot)
+{
+    ucs_assert(slot->generation & 1);
+
+    slot->ptr       = NULL;
+    slot->next_free = map->free_head;
+    ++slot->generation;
+    --map->count;
+    map->free_head  = slot - map->slots;
+}
+
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucs_ptr_map_put(ucs_ptr_map_t *map, void *ptr, int indirect,
                 ucs_ptr_map_key_t *key, int is_put_thread_safe,
-                ucs_ptr_safe_hash_t *safe_hash)
+                ucs_ptr_map_safe_t *safe)
 {
     if (ucs_likely(!indirect)) {
         *key = (uintptr_t)ptr;
@@ -89,43 +146,50 @@ ucs_ptr_map_put(ucs_ptr_map_t *map, void *ptr, int indirect,
     }
 
     if (is_put_thread_safe) {
-        return ucs_ptr_safe_hash_put(map, ptr, key, safe_hash);
+        return ucs_ptr_map_safe_put(map, ptr, key, safe);
     }
 
-    *key = ucs_ptr_map_create_key(map);
-    return ucs_ptr_hash_put(&map->hash, *key, ptr);
+    return ucs_ptr_map_slot_put(map, ptr, key, 0, NULL);
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucs_ptr_map_get(ucs_ptr_map_t *map, ucs_ptr_map_key_t key, int extract,
                 void **ptr_p, int is_put_thread_safe,
-                ucs_ptr_safe_hash_t *safe_hash)
+                ucs_ptr_map_safe_t *safe)
 {
-    ucs_status_t status;
+    ucs_ptr_map_slot_t *slot;
 
     if (ucs_likely(!ucs_ptr_map_key_indirect(key))) {
         *ptr_p = (void*)key;
         return UCS_ERR_NO_PROGRESS;
     }
 
-    status = ucs_ptr_hash_get(&map->hash, key, extract, ptr_p);
-    if (ucs_likely(status != UCS_ERR_NO_ELEM)) {
-        return status;
+    slot = ucs_ptr_map_slot_find(map, key, is_put_thread_safe);
+    if (ucs_unlikely(slot == NULL)) {
+        *ptr_p = NULL; /* To suppress compiler warning */
+        return UCS_ERR_NO_ELEM;
+    }
+
+    *ptr_p = slot->ptr;
+    if (!extract) {
+        return UCS_OK;
     }
 
     if (is_put_thread_safe) {
-        status = ucs_ptr_safe_hash_get(map, key, extract, ptr_p, safe_hash);
+        /* The free list is shared with concurrent put operations */
+        return ucs_ptr_map_safe_del(map, key, safe);
     }
 
-    return status;
+    ucs_ptr_map_slot_release(map, slot);
+    return UCS_OK;
 }
 
 static UCS_F_ALWAYS_INLINE ucs_status_t
 ucs_ptr_map_del(ucs_ptr_map_t *map, ucs_ptr_map_key_t key,
-                int is_put_thread_safe, ucs_ptr_safe_hash_t *safe_hash)
+                int is_put_thread_safe, ucs_ptr_map_safe_t *safe)
 {
     void UCS_V_UNUSED *dummy;
-    return ucs_ptr_map_get(map, key, 1, &dummy, is_put_thread_safe, safe_hash);
+    return ucs_ptr_map_get(map, key, 1, &dummy, is_put_thread_safe, safe);
 }
 
 #define UCS_PTR_MAP_IMPL(_name, _is_put_thread_safe) \
@@ -0,0 +1,544 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#ifndef UCS_SWISS_HASH_H_
+#define UCS_SWISS_HASH_H_
+
+#include <ucs/arch/bitops.h>
+#include <ucs/debug/assert.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/compiler_def.h>
+#include <ucs/sys/math.h>
+#include <ucs/type/status.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#  include <emmintrin.h>
+#elif defined(__aarch64__)
+#  include <arm_neon.h>
+#endif
+
+BEGIN_C_DECLS
+
+
+/*
+ * Open-addressing hash table with a separate array of one-byte control words,
+ * in the spirit of "Swiss tables". Slots are split to groups of
+ * UCS_SWISS_HASH_GROUP_SIZE, and a whole group of control words is matched
+ * against the 7-bit hash fragment of the key in a few SIMD instructions, so a
+ * lookup typically touches a single control group and a single slot.
+ *
+ * Control word values:
+ *  - EMPTY   : the slot was never used since the last rehash.
+ *  - DELETED : the slot was used and then removed (tombstone).
+ *  - 0..127  : the slot is used, the value is the 7-bit hash fragment (h2).
+ *
+ * The table is never filled beyond 7/8 of its capacity (including tombstones),
+ * so every probe sequence ends at a group which contains an EMPTY slot.
+ *
+ * The API is similar to khash:
+ *
+ * @code{.c}
+ * UCS_SWISS_HASH_TYPE(my_hash, uint64_t, int)
+ * UCS_SWISS_HASH_IMPL(my_hash, uint64_t, int, ucs_swiss_hash_int64_func,
+ *                     ucs_swiss_hash_int64_equal)
+ *
+ * ucs_swiss_hash_t(my_hash) h;
+ * ucs_swiss_hash_iter_t iter;
+ * int ret;
+ *
+ * ucs_swiss_hash_init(my_hash, &h);
+ * iter = ucs_swiss_hash_put(my_hash, &h, 5, &ret);
+ * ucs_swiss_hash_value(&h, iter) = 10;
+ * iter = ucs_swiss_hash_get(my_hash, &h, 5);
+ * if (iter != ucs_swiss_hash_end(&h)) {
+ *     ...
+ * }
+ * ucs_swiss_hash_destroy(my_hash, &h);
+ * @endcode
+ */
+
+
+/* Number of slots in a control group */
+#define UCS_SWISS_HASH_GROUP_SIZE  16
+
+
+/* Control word values */
+#define UCS_SWISS_HASH_CTRL_EMPTY   ((int8_t)-128)
+#define UCS_SWISS_HASH_CTRL_DELETED ((int8_t)-2)
+
+
+/* Return values of @ref ucs_swiss_hash_put, same as for kh_put */
+typedef enum {
+    UCS_SWISS_HASH_PUT_FAILED       = -1,
+    UCS_SWISS_HASH_PUT_KEY_PRESENT  = 0,
+    UCS_SWISS_HASH_PUT_BUCKET_EMPTY = 1
+} ucs_swiss_hash_put_t;
+
+
+/* Slot index in the hash table */
+typedef uint32_t ucs_swiss_hash_iter_t;
+
+
+/*
+ * Bit mask of matching slots in a control group. With NEON every slot is
+ * represented by 4 bits, and otherwise by a single bit.
+ */
+typedef uint64_t ucs_swiss_hash_mask_t;
+
+
+/* Control group of an empty table, so lookups do not need a special case */
+static const int8_t
+ucs_swiss_hash_empty_group[UCS_SWISS_HASH_GROUP_SIZE] UCS_V_ALIGNED(16) = {
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY,
+    UCS_SWISS_HASH_CTRL_EMPTY, UCS_SWISS_HASH_CTRL_EMPTY
+};
+
+
+#if defined(__SSE2__)
+
+#define UCS_SWISS_HASH_MASK_SHIFT 0
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match(const int8_t *group, int8_t h2)
+{
+    __m128i ctrl = _mm_loadu_si128((const __m128i*)group);
+    return (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2),
+                                                      ctrl));
+}
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match_free(const int8_t *group)
+{
+    /* EMPTY and DELETED are the only negative control values */
+    return (uint16_t)_mm_movemask_epi8(
+            _mm_loadu_si128((const __m128i*)group));
+}
+
+#elif defined(__aarch64__)
+
+#define UCS_SWISS_HASH_MASK_SHIFT 2
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_neon_mask(uint8x16_t cmp)
+{
+    /* Narrow every 8-bit lane to 4 bits, and keep one bit per slot */
+    uint8x8_t narrow = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(narrow), 0) &
+           0x8888888888888888ul;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match(const int8_t *group, int8_t h2)
+{
+    return ucs_swiss_hash_neon_mask(vceqq_s8(vld1q_s8(group), vdupq_n_s8(h2)));
+}
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match_free(const int8_t *group)
+{
+    return ucs_swiss_hash_neon_mask(vcltzq_s8(vld1q_s8(group)));
+}
+
+#else
+
+#define UCS_SWISS_HASH_MASK_SHIFT 0
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match(const int8_t *group, int8_t h2)
+{
+    ucs_swiss_hash_mask_t mask = 0;
+    unsigned i;
+
+    for (i = 0; i < UCS_SWISS_HASH_GROUP_SIZE; ++i) {
+        mask |= (ucs_swiss_hash_mask_t)(group[i] == h2) << i;
+    }
+    return mask;
+}
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match_free(const int8_t *group)
+{
+    ucs_swiss_hash_mask_t mask = 0;
+    unsigned i;
+
+    for (i = 0; i < UCS_SWISS_HASH_GROUP_SIZE; ++i) {
+        mask |= (ucs_swiss_hash_mask_t)(group[i] < 0) << i;
+    }
+    return mask;
+}
+
+#endif
+
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_mask_t
+ucs_swiss_hash_group_match_empty(const int8_t *group)
+{
+    return ucs_swiss_hash_group_match(group, UCS_SWISS_HASH_CTRL_EMPTY);
+}
+
+
+/* Remove the lowest matching slot from the mask and return its index */
+static UCS_F_ALWAYS_INLINE unsigned
+ucs_swiss_hash_mask_next(ucs_swiss_hash_mask_t *mask_p)
+{
+    unsigned index = ucs_count_trailing_zero_bits(*mask_p) >>
+                     UCS_SWISS_HASH_MASK_SHIFT;
+
+    *mask_p &= *mask_p - 1;
+    return index;
+}
+
+
+/*
+ * Mix the user hash value, so both the group index and the 7-bit fragment
+ * depend on all bits of the key.
+ */
+static UCS_F_ALWAYS_INLINE uint64_t ucs_swiss_hash_mix(uint64_t hash)
+{
+    hash *= 0x9e3779b97f4a7c15ul;
+    return hash ^ (hash >> 32);
+}
+
+
+static UCS_F_ALWAYS_INLINE ucs_swiss_hash_iter_t
+ucs_swiss_hash_ctrl_next(const int8_t *ctrl, uint32_t capacity,
+                         ucs_swiss_hash_iter_t iter)
+{
+    while ((iter < capacity) && (ctrl[iter] < 0)) {
+        ++iter;
+    }
+    return iter;
+}
+
+
+/* Maximal number of used and deleted slots for a given capacity */
+#define ucs_swiss_hash_max_load(_capacity) \
+    ((_capacity) - ((_capacity) / 8))
+
+
+/* Default hash and equality functions for integer and pointer keys */
+#define ucs_swiss_hash_int64_func(_key)         ((uint64_t)(_key))
+#define ucs_swiss_hash_int64_equal(_key1, _key2) ((_key1) == (_key2))
+
+
+/**
+ * Declare a hash table type.
+ *
+ * @param _name   Hash table name, used to generate type and function names.
+ * @param _key_t  Key type.
+ * @param _val_t  Value type.
+ */
+#define UCS_SWISS_HASH_TYPE(_name, _key_t, _val_t) \
+    typedef struct { \
+        _key_t key; \
+        _val_t value; \
+    } ucs_swiss_hash_##_name##_slot_t; \
+    \
+    typedef struct { \
+        int8_t                          *ctrl; /* Control words */ \
+        ucs_swiss_hash_##_name##_slot_t *slots; /* Keys and values */ \
+        uint32_t                        capacity; /* Number of slots */ \
+        uint32_t                        group_mask; /* Number of groups - 1 */ \
+        uint32_t                        size; /* Number of used slots */ \
+        uint32_t                        growth_left; /* Empty slots to use
+                                                        before rehash */ \
+    } ucs_swiss_hash_##_name##_t;
+
+
+/**
+ * Generate the hash table functions.
+ *
+ * @param _name        Hash table name, as passed to @ref UCS_SWISS_HASH_TYPE.
+ * @param _key_t       Key type.
+ * @param _val_t       Value type.
+ * @param _hash_func   Function or macro which returns a 64-bit hash of a key.
+ *                     The value is mixed internally, so it does not have to be
+ *                     uniformly distributed.
+ * @param _equal_func  Function or macro which returns nonzero if two keys are
+ *                     equal.
+ */
+#define UCS_SWISS_HASH_IMPL(_name, _key_t, _val_t, _hash_func, _equal_func) \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_hash_##_name##_init(ucs_swiss_hash_##_name##_t *h) \
+    { \
+        h->ctrl        = (int8_t*)ucs_swiss_hash_empty_group; \
+        h->slots       = NULL; \
+        h->capacity    = 0; \
+        h->group_mask  = 0; \
+        h->size        = 0; \
+        h->growth_left = 0; \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_hash_##_name##_destroy(ucs_swiss_hash_##_name##_t *h) \
+    { \
+        if (h->capacity != 0) { \
+            ucs_free(h->ctrl); \
+        } \
+        ucs_swiss_hash_##_name##_init(h); \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED UCS_F_ALWAYS_INLINE ucs_swiss_hash_iter_t \
+    ucs_swiss_hash_##_name##_find(const ucs_swiss_hash_##_name##_t *h, \
+                                  _key_t key, uint64_t hash) \
+    { \
+        int8_t h2          = hash & 0x7f; \
+        uint32_t group     = (hash >> 7) & h->group_mask; \
+        uint32_t step      = 0; \
+        const int8_t *ctrl; \
+        ucs_swiss_hash_mask_t mask; \
+        ucs_swiss_hash_iter_t iter; \
+        \
+        for (;;) { \
+            ctrl = h->ctrl + (group * UCS_SWISS_HASH_GROUP_SIZE); \
+            mask = ucs_swiss_hash_group_match(ctrl, h2); \
+            while (mask != 0) { \
+                iter = (group * UCS_SWISS_HASH_GROUP_SIZE) + \
+                       ucs_swiss_hash_mask_next(&mask); \
+                if (ucs_likely(_equal_func(h->slots[iter].key, key))) { \
+                    return iter; \
+                } \
+            } \
+            \
+            if (ucs_likely(ucs_swiss_hash_group_match_empty(ctrl) != 0)) { \
+                return h->capacity; \
+            } \
+            \
+            /* Triangular probing visits every group once */ \
+            group = (group + (++step)) & h->group_mask; \
+        } \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED UCS_F_ALWAYS_INLINE ucs_swiss_hash_iter_t \
+    ucs_swiss_hash_##_name##_get(const ucs_swiss_hash_##_name##_t *h, \
+                                 _key_t key) \
+    { \
+        return ucs_swiss_hash_##_name##_find( \
+                h, key, ucs_swiss_hash_mix(_hash_func(key))); \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED ucs_swiss_hash_iter_t \
+    ucs_swiss_hash_##_name##_find_free(const ucs_swiss_hash_##_name##_t *h, \
+                                       uint64_t hash) \
+    { \
+        uint32_t group = (hash >> 7) & h->group_mask; \
+        uint32_t step  = 0; \
+        ucs_swiss_hash_mask_t mask; \
+        \
+        for (;;) { \
+            mask = ucs_swiss_hash_group_match_free( \
+                    h->ctrl + (group * UCS_SWISS_HASH_GROUP_SIZE)); \
+            if (mask != 0) { \
+                return (group * UCS_SWISS_HASH_GROUP_SIZE) + \
+                       ucs_swiss_hash_mask_next(&mask); \
+            } \
+            \
+            group = (group + (++step)) & h->group_mask; \
+        } \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED ucs_status_t \
+    ucs_swiss_hash_##_name##_resize(ucs_swiss_hash_##_name##_t *h, \
+                                    uint32_t capacity) \
+    { \
+        ucs_swiss_hash_##_name##_t new_h; \
+        ucs_swiss_hash_iter_t iter, new_iter; \
+        uint64_t hash; \
+        \
+        ucs_assert(ucs_is_pow2(capacity)); \
+        ucs_assert(capacity >= UCS_SWISS_HASH_GROUP_SIZE); \
+        ucs_assert(ucs_swiss_hash_max_load(capacity) > h->size); \
+        \
+        /* Slots are placed after the control words, which are a multiple of \
+         * the group size and therefore keep the alignment */ \
+        new_h.ctrl = (int8_t*)ucs_malloc( \
+                capacity * (1 + sizeof(*new_h.slots)), "swiss_hash_" #_name); \
+        if (new_h.ctrl == NULL) { \
+            return UCS_ERR_NO_MEMORY; \
+        } \
+        \
+        memset(new_h.ctrl, UCS_SWISS_HASH_CTRL_EMPTY, capacity); \
+        new_h.slots       = (ucs_swiss_hash_##_name##_slot_t*)( \
+                new_h.ctrl + capacity); \
+        new_h.capacity    = capacity; \
+        new_h.group_mask  = (capacity / UCS_SWISS_HASH_GROUP_SIZE) - 1; \
+        new_h.size        = h->size; \
+        new_h.growth_left = ucs_swiss_hash_max_load(capacity) - h->size; \
+        \
+        for (iter = 0; iter < h->capacity; ++iter) { \
+            if (h->ctrl[iter] < 0) { \
+                continue; \
+            } \
+            \
+            hash                     = ucs_swiss_hash_mix( \
+                    _hash_func(h->slots[iter].key)); \
+            new_iter                 = ucs_swiss_hash_##_name##_find_free( \
+                    &new_h, hash); \
+            new_h.ctrl[new_iter]     = hash & 0x7f; \
+            new_h.slots[new_iter]    = h->slots[iter]; \
+        } \
+        \
+        ucs_swiss_hash_##_name##_destroy(h); \
+        *h = new_h; \
+        return UCS_OK; \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED ucs_swiss_hash_iter_t \
+    ucs_swiss_hash_##_name##_put(ucs_swiss_hash_##_name##_t *h, _key_t key, \
+                                 int *ret_p) \
+    { \
+        uint64_t hash = ucs_swiss_hash_mix(_hash_func(key)); \
+        ucs_swiss_hash_iter_t iter; \
+        uint32_t capacity; \
+        \
+        iter = ucs_swiss_hash_##_name##_find(h, key, hash); \
+        if (iter != h->capacity) { \
+            *ret_p = UCS_SWISS_HASH_PUT_KEY_PRESENT; \
+            return iter; \
+        } \
+        \
+        if (h->growth_left == 0) { \
+            /* Grow if the table is at least half full, otherwise just \
+             * rehash in place to drop the tombstones */ \
+            capacity = h->capacity; \
+            if (capacity == 0) { \
+                capacity = UCS_SWISS_HASH_GROUP_SIZE; \
+            } else if (h->size >= (ucs_swiss_hash_max_load(capacity) / 2)) { \
+                capacity *= 2; \
+            } \
+            \
+            if (ucs_swiss_hash_##_name##_resize(h, capacity) != UCS_OK) { \
+                *ret_p = UCS_SWISS_HASH_PUT_FAILED; \
+                return h->capacity; \
+            } \
+        } \
+        \
+        iter = ucs_swiss_hash_##_name##_find_free(h, hash); \
+        if (h->ctrl[iter] == UCS_SWISS_HASH_CTRL_EMPTY) { \
+            --h->growth_left; \
+        } \
+        \
+        h->ctrl[iter]      = hash & 0x7f; \
+        h->slots[iter].key = key; \
+        ++h->size; \
+        *ret_p = UCS_SWISS_HASH_PUT_BUCKET_EMPTY; \
+        return iter; \
+    } \
+    \
+    static UCS_F_MAYBE_UNUSED void \
+    ucs_swiss_hash_##_name##_del(ucs_swiss_hash_##_name##_t *h, \
+                                 ucs_swiss_hash_iter_t iter) \
+    { \
+        int8_t *group = h->ctrl + (iter & ~(UCS_SWISS_HASH_GROUP_SIZE - 1)); \
+        \
+        ucs_assert(iter < h->capacity); \
+        ucs_assert(h->ctrl[iter] >= 0); \
+        \
+        /* If the group has an empty slot, no probe sequence has ever passed \
+         * through it, so the slot can be marked as empty again */ \
+        if (ucs_swiss_hash_group_match_empty(group) != 0) { \
+            h->ctrl[iter] = UCS_SWISS_HASH_CTRL_EMPTY; \
+            ++h->growth_left; \
+        } else { \
+            h->ctrl[iter] = UCS_SWISS_HASH_CTRL_DELETED; \
+        } \
+        --h->size; \
+    }
+
+
+/**
+ * Hash table type.
+ *
+ * @param _name  Hash table name.
+ */
+#define ucs_swiss_hash_t(_name) ucs_swiss_hash_##_name##_t
+
+
+/**
+ * Initialize an empty hash table. Does not allocate memory.
+ */
+#define ucs_swiss_hash_init(_name, _h) ucs_swiss_hash_##_name##_init(_h)
+
+
+/**
+ * Release the memory of a hash table and make it empty.
+ */
+#define ucs_swiss_hash_destroy(_name, _h) ucs_swiss_hash_##_name##_destroy(_h)
+
+
+/**
+ * Find a key in the hash table.
+ *
+ * @return Iterator to the key, or @ref ucs_swiss_hash_end if not found.
+ */
+#define ucs_swiss_hash_get(_name, _h, _key) \
+    ucs_swiss_hash_##_name##_get(_h, _key)
+
+
+/**
+ * Insert a key to the hash table. The value of a new key is not initialized.
+ * Inserting may move existing elements, so iterators and pointers to values
+ * are invalidated unless the key was present.
+ *
+ * @param [out] _ret_p  Filled with @ref ucs_swiss_hash_put_t.
+ *
+ * @return Iterator to the key, or @ref ucs_swiss_hash_end on failure.
+ */
+#define ucs_swiss_hash_put(_name, _h, _key, _ret_p) \
+    ucs_swiss_hash_##_name##_put(_h, _key, _ret_p)
+
+
+/**
+ * Remove an element, pointed by an iterator, from the hash table.
+ */
+#define ucs_swiss_hash_del(_name, _h, _iter) \
+    ucs_swiss_hash_##_name##_del(_h, _iter)
+
+
+/**
+ * Iterator which denotes a missing key.
+ */
+#define ucs_swiss_hash_end(_h) ((_h)->capacity)
+
+
+/**
+ * Key and value of an element pointed by an iterator.
+ */
+#define ucs_swiss_hash_key(_h, _iter)   ((_h)->slots[_iter].key)
+#define ucs_swiss_hash_value(_h, _iter) ((_h)->slots[_iter].value)
+
+
+/**
+ * Number of elements in the hash table.
+ */
+#define ucs_swiss_hash_size(_h) ((_h)->size)
+
+
+/**
+ * Iterate over all elements of a hash table.
+ *
+ * @param _h     Hash table.
+ * @param _iter  Iterator variable, of type @ref ucs_swiss_hash_iter_t.
+ */
+#define ucs_swiss_hash_for_each(_h, _iter) \
+    for ((_iter) = ucs_swiss_hash_ctrl_next((_h)->ctrl, (_h)->capacity, 0); \
+         (_iter) < (_h)->capacity; \
+         (_iter) = ucs_swiss_hash_ctrl_next((_h)->ctrl, (_h)->capacity, \
+                                            (_iter) + 1))
+
+END_C_DECLS
+
+#endif
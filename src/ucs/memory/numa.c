@@ -10,16 +10,23 @@
 
 #include "numa.h"
 
-#include <ucs/datastruct/khash.h>
+#include <ucs/arch/cpu.h>
 #include <ucs/debug/assert.h>
 #include <ucs/debug/log.h>
+#include <ucs/debug/memtrack_int.h>
+#include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/string.h>
 #include <ucs/sys/sys.h>
-#include <ucs/type/spinlock.h>
+#include <ucs/type/init_once.h>
 #include <stdint.h>
 #include <sched.h>
 #include <dirent.h>
 
+#ifdef HAVE_LINUX_MEMPOLICY_H
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
 #define UCS_NUMA_MIN_DISTANCE       10
 #define UCS_NUMA_NODE_MAX           INT16_MAX
 #define UCS_NUMA_CORE_DIR_PATH      UCS_SYS_FS_CPUS_PATH "/cpu%d"
@@ -27,28 +34,29 @@
 #define UCS_NUMA_NODE_DISTANCE_PATH UCS_NUMA_NODES_DIR_PATH "/node%d/distance"
 
 
-KHASH_MAP_INIT_INT(numa_distance, ucs_numa_distance_t);
-
 typedef struct {
     unsigned     max_index;
     const char   *prefix;
     const size_t prefix_length;
 } ucs_numa_get_max_dirent_ctx_t;
 
+/* Distances between all pairs of nodes, row by row */
 typedef struct {
-    ucs_spinlock_t         lock;
-    khash_t(numa_distance) numa_distance_hash;
-} ucs_numa_global_ctx_t;
-
-static ucs_numa_global_ctx_t ucs_numa_global_ctx;
+    unsigned            num_nodes;
+    ucs_numa_distance_t distances[0];
+} ucs_numa_distance_matrix_t;
 
-static inline uint32_t ucs_numa_distance_hash_key(const ucs_numa_node_t node1,
-                                                  const ucs_numa_node_t node2)
-{
-    static const uint8_t shift = sizeof(ucs_numa_node_t) * 8;
+typedef struct {
+    ucs_init_once_t            init_once;
+    /* Built once on first use, and never changed afterwards, so it is read
+     * without locking */
+    ucs_numa_distance_matrix_t *distance_matrix;
+} ucs_numa_global_ctx_t;
 
-    return (ucs_max(node1, node2) << shift) | ucs_min(node1, node2);
-}
+static ucs_numa_global_ctx_t ucs_numa_global_ctx = {
+    .init_once       = UCS_INIT_ONCE_INITIALIZER,
+    .distance_matrix = NULL
+};
 
 static ucs_status_t
 ucs_numa_get_max_dirent_cb(const struct dirent *entry, void *arg)
@@ -160,33 +168,29 @@ ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path)
 }
 
 /**
- * Parse and iterate the distance list of @param source.
- * For each neighbor of source put distance(source, neighbor)
- * in @ref numa_distance_hash.
- *
- * @param [in]  source source NUMA node
- * @param [in]  dest   destination NUMA node
- *
- * @return Distance from @param source to @param dest
+ * Parse the distance list of @param source into @param distances, which has an
+ * entry for each one of @param num_nodes nodes.
  */
-static ucs_numa_distance_t
-ucs_numa_node_parse_distances(ucs_numa_node_t source, ucs_numa_node_t dest)
+static void ucs_numa_node_parse_distances(ucs_numa_node_t source,
+                                          unsigned num_nodes,
+                                          ucs_numa_distance_t *distances)
 {
-    ucs_numa_distance_t distance_to_dest = UCS_NUMA_MIN_DISTANCE;
-    ucs_numa_node_t node                 = 0;
+    unsigned node = 0;
     ucs_numa_distance_t distance;
-    ucs_kh_put_t kh_put_status;
-    khiter_t hash_it;
     FILE *distance_fp;
 
+    for (node = 0; node < num_nodes; ++node) {
+        distances[node] = UCS_NUMA_MIN_DISTANCE;
+    }
+
     distance_fp = ucs_open_file("r", UCS_LOG_LEVEL_DEBUG,
                                 UCS_NUMA_NODE_DISTANCE_PATH, source);
     if (distance_fp == NULL) {
-        return distance_to_dest;
+        return;
     }
 
-    while ((fscanf(distance_fp, "%u", &distance) > 0) &&
-           (node < UCS_NUMA_NODE_MAX)) {
+    node = 0;
+    while ((fscanf(distance_fp, "%u", &distance) > 0) && (node < num_nodes)) {
         if (distance < UCS_NUMA_MIN_DISTANCE) {
             ucs_debug("node %u parsed NUMA distance %u is "
                       "smaller than the lower bound (%u)",
@@ -194,63 +198,189 @@ ucs_numa_node_parse_distances(ucs_numa_node_t source, ucs_numa_node_t dest)
             distance = UCS_NUMA_MIN_DISTANCE;
         }
 
-        if (node == dest) {
-            distance_to_dest = distance;
-        }
+        distances[node++] = distance;
+    }
 
-        hash_it = kh_put(numa_distance, &ucs_numa_global_ctx.numa_distance_hash,
-                         ucs_numa_distance_hash_key(source, node),
-                         &kh_put_status);
-        if ((kh_put_status != UCS_KH_PUT_FAILED) &&
-            (kh_put_status != UCS_KH_PUT_KEY_PRESENT)) {
-            kh_value(&ucs_numa_global_ctx.numa_distance_hash,
-                     hash_it) = distance;
+    fclose(distance_fp);
+}
+
+static void ucs_numa_distance_matrix_init()
+{
+    unsigned num_nodes = ucs_numa_num_configured_nodes();
+    ucs_numa_distance_matrix_t *matrix;
+    ucs_numa_node_t node;
+
+    UCS_INIT_ONCE(&ucs_numa_global_ctx.init_once) {
+        matrix = ucs_malloc(sizeof(*matrix) + (sizeof(*matrix->distances) *
+                                               num_nodes * num_nodes),
+                            "numa_distance_matrix");
+        if (matrix == NULL) {
+            ucs_error("failed to allocate NUMA distance matrix for %u nodes",
+                      num_nodes);
+            continue;
         }
 
-        node++;
-    }
+        matrix->num_nodes = num_nodes;
+        for (node = 0; node < num_nodes; ++node) {
+            ucs_numa_node_parse_distances(node, num_nodes,
+                                          &matrix->distances[node * num_nodes]);
+        }
 
-    if (node >= UCS_NUMA_NODE_MAX) {
-        ucs_diag("number of nodes in the system is out of range (%u)",
-                 UCS_NUMA_NODE_MAX);
+        ucs_memory_cpu_store_fence();
+        ucs_numa_global_ctx.distance_matrix = matrix;
     }
-
-    fclose(distance_fp);
-    return distance_to_dest;
 }
 
 ucs_numa_distance_t
 ucs_numa_distance(ucs_numa_node_t node1, ucs_numa_node_t node2)
 {
-    ucs_numa_distance_t distance = UCS_NUMA_MIN_DISTANCE;
-    khiter_t hash_it;
+    const ucs_numa_distance_matrix_t *matrix;
 
     ucs_assert(node1 < ucs_numa_num_configured_nodes());
     ucs_assert(node2 < ucs_numa_num_configured_nodes());
 
-    ucs_spin_lock(&ucs_numa_global_ctx.lock);
-    hash_it = kh_get(numa_distance, &ucs_numa_global_ctx.numa_distance_hash,
-                     ucs_numa_distance_hash_key(node1, node2));
+    matrix = ucs_numa_global_ctx.distance_matrix;
+    if (ucs_unlikely(matrix == NULL)) {
+        ucs_numa_distance_matrix_init();
+        matrix = ucs_numa_global_ctx.distance_matrix;
+        if (matrix == NULL) {
+            return UCS_NUMA_MIN_DISTANCE;
+        }
+    }
 
-    if (ucs_likely(hash_it !=
-                   kh_end(&ucs_numa_global_ctx.numa_distance_hash))) {
-        distance = kh_value(&ucs_numa_global_ctx.numa_distance_hash, hash_it);
-    } else {
-        distance = ucs_numa_node_parse_distances(node1, node2);
+    return matrix->distances[(node1 * matrix->num_nodes) + node2];
+}
+
+ucs_numa_node_t ucs_numa_node_of_current_cpu()
+{
+    int cpu = sched_getcpu();
+
+    if ((cpu < 0) || (cpu >= __CPU_SETSIZE)) {
+        return UCS_NUMA_NODE_UNDEFINED;
     }
 
-    ucs_spin_unlock(&ucs_numa_global_ctx.lock);
-    return distance;
+    return ucs_numa_node_of_cpu(cpu);
 }
 
-void ucs_numa_init()
+#if defined(HAVE_LINUX_MEMPOLICY_H) && defined(__NR_mbind) && \
+    defined(__NR_set_mempolicy) && defined(__NR_get_mempolicy)
+
+static int ucs_numa_nodemask_init(ucs_numa_node_t node,
+                                  ucs_numa_policy_t *policy)
 {
-    ucs_spinlock_init(&ucs_numa_global_ctx.lock, 0);
-    kh_init_inplace(numa_distance, &ucs_numa_global_ctx.numa_distance_hash);
+    static const unsigned bits = 8 * sizeof(*policy->nodemask);
+
+    if ((node < 0) || (node >= UCS_NUMA_POLICY_MAX_NODES)) {
+        return 0;
+    }
+
+    memset(policy->nodemask, 0, sizeof(policy->nodemask));
+    policy->nodemask[node / bits] = UCS_BIT(node % bits);
+    policy->mode                  = MPOL_PREFERRED;
+    return 1;
+}
+
+ucs_numa_node_t ucs_numa_node_of_address(const void *address)
+{
+    int node;
+
+    if (syscall(__NR_get_mempolicy, &node, NULL, 0, address,
+                MPOL_F_NODE | MPOL_F_ADDR) < 0) {
+        ucs_debug("get_mempolicy(address=%p) failed: %m", address);
+        return UCS_NUMA_NODE_UNDEFINED;
+    }
+
+    return node;
 }
 
+ucs_status_t ucs_numa_bind(void *address, size_t length, ucs_numa_node_t node)
+{
+    size_t page_size = ucs_get_page_size();
+    ucs_numa_policy_t policy;
+    uintptr_t start, end;
+
+    if (!ucs_numa_nodemask_init(node, &policy)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    start = ucs_align_up_pow2((uintptr_t)address, page_size);
+    end   = ucs_align_down_pow2((uintptr_t)address + length, page_size);
+    if (start >= end) {
+        /* The range does not contain a whole page */
+        return UCS_OK;
+    }
+
+    /* Kernel expects the number of bits in the mask plus one */
+    if (syscall(__NR_mbind, start, end - start, policy.mode, policy.nodemask,
+                UCS_NUMA_POLICY_MAX_NODES + 1, MPOL_MF_MOVE) < 0) {
+        ucs_debug("mbind(0x%lx..0x%lx, node=%d) failed: %m", start, end,
+                  node);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t
+ucs_numa_policy_prefer(ucs_numa_node_t node, ucs_numa_policy_t *prev_policy)
+{
+    ucs_numa_policy_t policy;
+
+    if (!ucs_numa_nodemask_init(node, &policy)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (syscall(__NR_get_mempolicy, &prev_policy->mode, prev_policy->nodemask,
+                UCS_NUMA_POLICY_MAX_NODES, NULL, 0) < 0) {
+        ucs_debug("get_mempolicy() failed: %m");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    if (syscall(__NR_set_mempolicy, policy.mode, policy.nodemask,
+                UCS_NUMA_POLICY_MAX_NODES + 1) < 0) {
+        ucs_debug("set_mempolicy(node=%d) failed: %m", node);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+void ucs_numa_policy_restore(const ucs_numa_policy_t *policy)
+{
+    if (syscall(__NR_set_mempolicy, policy->mode, policy->nodemask,
+                UCS_NUMA_POLICY_MAX_NODES + 1) < 0) {
+        ucs_debug("set_mempolicy(mode=%d) failed: %m", policy->mode);
+    }
+}
+
+#else
+
+ucs_numa_node_t ucs_numa_node_of_address(const void *address)
+{
+    return UCS_NUMA_NODE_UNDEFINED;
+}
+
+ucs_status_t ucs_numa_bind(void *address, size_t length, ucs_numa_node_t node)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+ucs_status_t
+ucs_numa_policy_prefer(ucs_numa_node_t node, ucs_numa_policy_t *prev_policy)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void ucs_numa_policy_restore(const ucs_numa_policy_t *policy)
+{
+}
+
+#endif
+
 void ucs_numa_cleanup()
 {
-    kh_destroy_inplace(numa_distance, &ucs_numa_global_ctx.numa_distance_hash);
-    ucs_spinlock_destroy(&ucs_numa_global_ctx.lock);
+    UCS_CLEANUP_ONCE(&ucs_numa_global_ctx.init_once) {
+        ucs_free(ucs_numa_global_ctx.distance_matrix);
+        ucs_numa_global_ctx.distance_matrix = NULL;
+    }
 }
@@ -7,10 +7,13 @@
 #ifndef UCS_NUMA_H_
 #define UCS_NUMA_H_
 
+#include <ucs/type/status.h>
+#include <stddef.h>
 #include <stdint.h>
 
-#define UCS_NUMA_NODE_DEFAULT    0
-#define UCS_NUMA_NODE_UNDEFINED -1
+#define UCS_NUMA_NODE_DEFAULT     0
+#define UCS_NUMA_NODE_UNDEFINED  -1
+#define UCS_NUMA_POLICY_MAX_NODES 1024
 
 typedef int ucs_numa_distance_t;
 
@@ -18,10 +21,17 @@ typedef int ucs_numa_distance_t;
 typedef int16_t ucs_numa_node_t;
 
 
-extern const char *ucs_numa_policy_names[];
+/**
+ * Memory allocation policy of the calling thread.
+ */
+typedef struct {
+    int           mode;
+    unsigned long nodemask[UCS_NUMA_POLICY_MAX_NODES /
+                           (8 * sizeof(unsigned long))];
+} ucs_numa_policy_t;
 
 
-void ucs_numa_init();
+extern const char *ucs_numa_policy_names[];
 
 
 void ucs_numa_cleanup();
@@ -66,4 +76,58 @@ ucs_numa_node_t ucs_numa_node_of_device(const char *dev_path);
 ucs_numa_distance_t
 ucs_numa_distance(ucs_numa_node_t node1, ucs_numa_node_t node2);
 
+
+/**
+ * @return The node of the CPU the calling thread is running on, or
+ *         UCS_NUMA_NODE_UNDEFINED if it cannot be determined.
+ */
+ucs_numa_node_t ucs_numa_node_of_current_cpu();
+
+
+/**
+ * @param [in]  address Address to query.
+ *
+ * @return The node that the page containing @a address resides on, or
+ *         UCS_NUMA_NODE_UNDEFINED if the page is not populated or the node
+ *         cannot be determined.
+ */
+ucs_numa_node_t ucs_numa_node_of_address(const void *address);
+
+
+/**
+ * Prefer allocating the pages of a memory range on a given node. Pages which
+ * are already populated are migrated to the node, when possible. Only whole
+ * pages inside the range are affected.
+ *
+ * @param [in]  address Start of the memory range.
+ * @param [in]  length  Length of the memory range.
+ * @param [in]  node    NUMA node to prefer.
+ *
+ * @return UCS_OK, or UCS_ERR_UNSUPPORTED if the system does not support
+ *         memory policies.
+ */
+ucs_status_t ucs_numa_bind(void *address, size_t length, ucs_numa_node_t node);
+
+
+/**
+ * Prefer allocating memory on a given node for pages which are populated by
+ * the calling thread, until @ref ucs_numa_policy_restore is called.
+ *
+ * @param [in]  node        NUMA node to prefer.
+ * @param [out] prev_policy Filled with the previous policy of the thread.
+ *
+ * @return UCS_OK, or UCS_ERR_UNSUPPORTED if the system does not support
+ *         memory policies.
+ */
+ucs_status_t
+ucs_numa_policy_prefer(ucs_numa_node_t node, ucs_numa_policy_t *prev_policy);
+
+
+/**
+ * Restore the memory allocation policy of the calling thread.
+ *
+ * @param [in]  policy Policy returned by @ref ucs_numa_policy_prefer.
+ */
+void ucs_numa_policy_restore(const ucs_numa_policy_t *policy);
+
 #endif
@@ -88,6 +88,7 @@ static ucs_stats_class_t ucs_rcache_stats_class = {
         [UCS_RCACHE_MERGES]             = "regions_merged",
         [UCS_RCACHE_UNMAPS]             = "unmap_events",
         [UCS_RCACHE_UNMAP_INVALIDATES]  = "regions_inv_unmap",
+        [UCS_RCACHE_UNMAPS_MERGED]      = "unmap_events_merged",
         [UCS_RCACHE_PUTS]               = "puts",
         [UCS_RCACHE_REGS]               = "mem_regs",
         [UCS_RCACHE_DEREGS]             = "mem_deregs",
@@ -117,10 +118,22 @@ ucs_config_field_t ucs_config_rcache_table[] = {
      ucs_offsetof(ucs_rcache_config_t, max_unreleased),
      UCS_CONFIG_TYPE_MEMUNITS},
 
+    {"RCACHE_GC_BATCH", "16",
+     "Maximal number of invalidated regions to deregister during a single memory\n"
+     "registration. The remaining regions are deregistered by the following\n"
+     "registrations, or from the async thread.",
+     ucs_offsetof(ucs_rcache_config_t, gc_batch), UCS_CONFIG_TYPE_ULUNITS},
+
     {"RCACHE_PURGE_ON_FORK", "y",
      "Purge registration cache upon fork",
      ucs_offsetof(ucs_rcache_config_t, purge_on_fork), UCS_CONFIG_TYPE_BOOL},
 
+    {"RCACHE_UFFD", "n",
+     "Invalidate the registration cache using unmap notifications from a\n"
+     "userfaultfd, instead of UCM memory hooks. Memory which does not support\n"
+     "it, such as file-backed mappings, is registered without caching.",
+     ucs_offsetof(ucs_rcache_config_t, uffd), UCS_CONFIG_TYPE_BOOL},
+
     {NULL}
 };
 
@@ -187,6 +200,7 @@ void ucs_rcache_set_default_params(ucs_rcache_params_t *rcache_params)
     rcache_params->max_regions        = UCS_MEMUNITS_INF;
     rcache_params->max_size           = UCS_MEMUNITS_INF;
     rcache_params->max_unreleased     = UCS_MEMUNITS_INF;
+    rcache_params->gc_batch           = UCS_ULUNITS_INF;
 }
 
 void ucs_rcache_set_params(ucs_rcache_params_t *rcache_params,
@@ -198,8 +212,12 @@ void ucs_rcache_set_params(ucs_rcache_params_t *rcache_params,
     rcache_params->max_regions        = rcache_config->max_regions;
     rcache_params->max_size           = rcache_config->max_size;
     rcache_params->max_unreleased     = rcache_config->max_unreleased;
+    rcache_params->gc_batch           = rcache_config->gc_batch;
     rcache_params->flags              = !rcache_config->purge_on_fork ? 0 :
                                         UCS_RCACHE_FLAG_PURGE_ON_FORK;
+    if (rcache_config->uffd) {
+        rcache_params->flags         |= UCS_RCACHE_FLAG_UFFD_EVENTS;
+    }
 }
 
 static size_t ucs_rcache_stat_max_pow2()
@@ -587,14 +605,23 @@ static void ucs_rcache_check_inv_queue(ucs_rcache_t *rcache, unsigned flags)
     ucs_spin_unlock(&rcache->lock);
 }
 
-static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock)
+static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock,
+                                     unsigned long max_regions)
 {
+    unsigned long count = 0;
     ucs_rcache_region_t *region;
 
-    ucs_trace_func("rcache=%s", rcache->name);
+    ucs_trace_func("rcache=%s max_regions=%lu", rcache->name, max_regions);
 
     ucs_spin_lock(&rcache->lock);
     while (!ucs_list_is_empty(&rcache->gc_list)) {
+        if (count++ >= max_regions) {
+            /* Deregistration is expensive, so after a burst of memory release
+             * let the async thread complete it instead of the caller */
+            ucs_async_pipe_push(&ucs_rcache_global_context.pipe);
+            break;
+        }
+
         region = ucs_list_extract_head(&rcache->gc_list, ucs_rcache_region_t,
                                        tmp_list);
         ucs_rcache_remove_from_unreleased(rcache, region->super.start,
@@ -613,34 +640,60 @@ static void ucs_rcache_check_gc_list(ucs_rcache_t *rcache, int drop_lock)
     ucs_spin_unlock(&rcache->lock);
 }
 
-static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
-                                         ucm_event_t *event, void *arg)
+/* Extend the last invalidation entry if it overlaps or touches the range */
+static int ucs_rcache_inv_queue_merge(ucs_rcache_t *rcache,
+                                      ucs_pgt_addr_t start, ucs_pgt_addr_t end)
 {
-    ucs_rcache_t *rcache = arg;
     ucs_rcache_inv_entry_t *entry;
-    ucs_pgt_addr_t start, end;
+    int merged = 0;
 
-    ucs_assert(event_type == UCM_EVENT_VM_UNMAPPED ||
-               event_type == UCM_EVENT_MEM_TYPE_FREE);
+    ucs_spin_lock(&rcache->lock);
+    if (!ucs_queue_is_empty(&rcache->inv_q)) {
+        entry = ucs_queue_tail_elem_non_empty(&rcache->inv_q,
+                                              ucs_rcache_inv_entry_t, queue);
+        if ((start <= entry->end) && (end >= entry->start)) {
+            rcache->unreleased_size -= entry->end - entry->start;
+            entry->start             = ucs_min(entry->start, start);
+            entry->end               = ucs_max(entry->end, end);
+            rcache->unreleased_size += entry->end - entry->start;
+            UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAPS, 1);
+            UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_UNMAPS_MERGED,
+                                     1);
+            merged = 1;
+        }
+    }
+    ucs_spin_unlock(&rcache->lock);
+
+    return merged;
+}
+
+/*
+ * Invalidate regions overlapping with an unmapped range. Returns nonzero if
+ * the range was left on the invalidation queue.
+ */
+static int ucs_rcache_unmapped(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                               ucs_pgt_addr_t end)
+{
+    ucs_rcache_inv_entry_t *entry;
 
     if (rcache->unreleased_size > rcache->params.max_unreleased) {
         /* Trigger a cleanup when the pending size exceeds the threshold */
         ucs_async_pipe_push(&ucs_rcache_global_context.pipe);
     }
 
-    if (event_type == UCM_EVENT_VM_UNMAPPED) {
-        start = (uintptr_t)event->vm_unmapped.address;
-        end   = (uintptr_t)event->vm_unmapped.address + event->vm_unmapped.size;
-    } else if(event_type == UCM_EVENT_MEM_TYPE_FREE) {
-        start = (uintptr_t)event->mem_type.address;
-        end   = (uintptr_t)event->mem_type.address + event->mem_type.size;
-    } else {
-        ucs_warn("%s: unknown event type: %x", rcache->name, event_type);
-        return;
-    }
-
     ucs_trace_func("%s: event vm_unmapped 0x%lx..0x%lx", rcache->name, start, end);
 
+    /*
+     * If invalidations are already pending, try to extend the last one. The
+     * queue has to be drained before any lookup anyway, so this avoids taking
+     * the page table lock on every event when the allocator releases memory
+     * in many small adjacent chunks.
+     */
+    if (!ucs_queue_is_empty(&rcache->inv_q) &&
+        ucs_rcache_inv_queue_merge(rcache, start, end)) {
+        return 1;
+    }
+
     /*
      * Try to lock the page table and invalidate the region immediately.
      * This way we avoid queuing endless events on the invalidation queue when
@@ -656,7 +709,7 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
         ucs_rcache_check_inv_queue(rcache, UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
         /* coverity[double_unlock] */
         pthread_rwlock_unlock(&rcache->pgt_lock);
-        return;
+        return 0;
     }
 
     /* Could not lock - add region to invalidation queue */
@@ -673,6 +726,48 @@ static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
                   "data corruption may occur", start, end);
     }
     ucs_spin_unlock(&rcache->lock);
+    return 1;
+}
+
+static void ucs_rcache_unmapped_callback(ucm_event_type_t event_type,
+                                         ucm_event_t *event, void *arg)
+{
+    ucs_rcache_t *rcache = arg;
+
+    ucs_assert(event_type == UCM_EVENT_VM_UNMAPPED ||
+               event_type == UCM_EVENT_MEM_TYPE_FREE);
+
+    if (event_type == UCM_EVENT_VM_UNMAPPED) {
+        ucs_rcache_unmapped(rcache, (uintptr_t)event->vm_unmapped.address,
+                            (uintptr_t)event->vm_unmapped.address +
+                            event->vm_unmapped.size);
+    } else if(event_type == UCM_EVENT_MEM_TYPE_FREE) {
+        ucs_rcache_unmapped(rcache, (uintptr_t)event->mem_type.address,
+                            (uintptr_t)event->mem_type.address +
+                            event->mem_type.size);
+    } else {
+        ucs_warn("%s: unknown event type: %x", rcache->name, event_type);
+    }
+}
+
+void ucs_rcache_unmapped_async(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                               ucs_pgt_addr_t end)
+{
+    if (ucs_rcache_unmapped(rcache, start, end)) {
+        /* Nobody may call into the rcache soon, so let the async thread
+         * process the invalidation queue */
+        ucs_async_pipe_push(&ucs_rcache_global_context.pipe);
+    }
+}
+
+/* UCM events the rcache handler is installed for */
+static int ucs_rcache_ucm_events(ucs_rcache_t *rcache)
+{
+    if (rcache->uffd) {
+        return rcache->params.ucm_events & ~UCM_EVENT_VM_UNMAPPED;
+    }
+
+    return rcache->params.ucm_events;
 }
 
 /* Clear all regions, called only during cleanup without holding the lock */
@@ -704,7 +799,7 @@ static void ucs_rcache_clean(ucs_rcache_t *rcache)
     pthread_rwlock_wrlock(&rcache->pgt_lock);
     /* coverity[double_lock]*/
     ucs_rcache_check_inv_queue(rcache, 0);
-    ucs_rcache_check_gc_list(rcache, 1);
+    ucs_rcache_check_gc_list(rcache, 1, UCS_ULUNITS_INF);
     pthread_rwlock_unlock(&rcache->pgt_lock);
 }
 
@@ -844,9 +939,12 @@ ucs_rcache_check_overlap(ucs_rcache_t *rcache, void *arg, ucs_pgt_addr_t *start,
     ucs_trace_func("rcache=%s, *start=0x%lx, *end=0x%lx", rcache->name, *start,
                    *end);
 
-    ucs_rcache_check_inv_queue(rcache, 0);
+    /* Invalidation must complete before looking up the page table, but
+     * deregistration of the invalidated regions is deferred to the GC list and
+     * done in bounded batches */
+    ucs_rcache_check_inv_queue(rcache, UCS_RCACHE_REGION_PUT_FLAG_ADD_TO_GC);
     /* coverity[double_unlock] */
-    ucs_rcache_check_gc_list(rcache, 1);
+    ucs_rcache_check_gc_list(rcache, 1, rcache->params.gc_batch);
 
     ucs_list_head_init(&region_list);
     ucs_rcache_find_regions(rcache, *start, *end - 1, &region_list);
@@ -1048,6 +1146,15 @@ retry:
         ucs_rcache_lru_evict(rcache);
     }
 
+    if (rcache->uffd &&
+        (ucs_rcache_uffd_register(region->super.start, region->super.end) !=
+         UCS_OK)) {
+        /* Unmapping this memory would not be reported, so do not cache it */
+        ucs_rcache_region_debug(rcache, region, "cannot be tracked, uncached");
+        ucs_rcache_region_invalidate_internal(
+                rcache, region, UCS_RCACHE_REGION_PUT_FLAG_IN_PGTABLE);
+    }
+
     UCS_STATS_UPDATE_COUNTER(rcache->stats, UCS_RCACHE_MISSES, 1);
 
     ucs_rcache_region_trace(rcache, region, "created");
@@ -1350,16 +1457,33 @@ static UCS_CLASS_INIT_FUNC(ucs_rcache_t, const ucs_rcache_params_t *params,
 
     ucs_rcache_vfs_init(self);
 
-    status = ucm_set_event_handler(params->ucm_events, params->ucm_event_priority,
+    self->uffd = 0;
+    if ((params->flags & UCS_RCACHE_FLAG_UFFD_EVENTS) &&
+        (params->ucm_events & UCM_EVENT_VM_UNMAPPED)) {
+        status = ucs_rcache_uffd_add(self);
+        if (status == UCS_OK) {
+            self->uffd = 1;
+        } else {
+            ucs_diag("%s: userfaultfd is not available, using UCM memory hooks",
+                     self->name);
+        }
+    }
+
+    status = ucm_set_event_handler(ucs_rcache_ucm_events(self),
+                                   params->ucm_event_priority,
                                    ucs_rcache_unmapped_callback, self);
     if (status != UCS_OK) {
         ucs_diag("rcache failed to install UCM event handler: %s",
                  ucs_status_string(status));
-        goto err_remove_vfs;
+        goto err_remove_uffd;
     }
 
     return UCS_OK;
 
+err_remove_uffd:
+    if (self->uffd) {
+        ucs_rcache_uffd_remove(self);
+    }
 err_remove_vfs:
     ucs_vfs_obj_remove(self);
     ucs_rcache_global_list_remove(self);
@@ -1383,12 +1507,15 @@ err:
 
 static UCS_CLASS_CLEANUP_FUNC(ucs_rcache_t)
 {
-    ucm_unset_event_handler(self->params.ucm_events, ucs_rcache_unmapped_callback,
-                            self);
+    ucm_unset_event_handler(ucs_rcache_ucm_events(self),
+                            ucs_rcache_unmapped_callback, self);
+    if (self->uffd) {
+        ucs_rcache_uffd_remove(self);
+    }
     ucs_vfs_obj_remove(self);
     ucs_rcache_global_list_remove(self);
     ucs_rcache_check_inv_queue(self, 0);
-    ucs_rcache_check_gc_list(self, 0);
+    ucs_rcache_check_gc_list(self, 0, UCS_ULUNITS_INF);
     ucs_rcache_purge(self);
 
     if (!ucs_list_is_empty(&self->lru.list)) {
@@ -61,6 +61,8 @@ enum {
     UCS_RCACHE_FLAG_NO_PFN_CHECK  = UCS_BIT(0), /**< PFN check not supported for this rcache */
     UCS_RCACHE_FLAG_PURGE_ON_FORK = UCS_BIT(1), /**< purge rcache on fork */
     UCS_RCACHE_FLAG_SYNC_EVENTS   = UCS_BIT(2), /**< Synchronize memory events handling */
+    UCS_RCACHE_FLAG_UFFD_EVENTS   = UCS_BIT(3), /**< Get unmap events from userfaultfd
+                                                     instead of UCM, if supported */
 };
 
 /*
@@ -154,6 +156,10 @@ struct ucs_rcache_params {
     unsigned long          max_regions;         /**< Maximal number of regions */
     size_t                 max_size;            /**< Maximal total size of regions */
     size_t                 max_unreleased;      /**< Threshold for triggering a cleanup */
+    unsigned long          gc_batch;            /**< Maximal number of invalidated
+                                                     regions to deregister during
+                                                     a registration, the rest are
+                                                     deregistered asynchronously */
 };
 
 
@@ -167,7 +173,10 @@ struct ucs_rcache_config {
     unsigned long max_regions;    /**< Maximal number of rcache regions */
     size_t        max_size;       /**< Maximal size of mapped memory */
     size_t        max_unreleased; /**< Threshold for triggering a cleanup */
+    unsigned long gc_batch;       /**< Maximal number of regions to deregister
+                                       during a registration */
     int           purge_on_fork;  /**< Enable/disable rcache purge on fork */
+    int           uffd;           /**< Use userfaultfd for unmap events */
 };
 
 
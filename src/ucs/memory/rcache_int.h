@@ -48,6 +48,8 @@ enum {
     UCS_RCACHE_UNMAPS,              /* number of memory unmap events */
     UCS_RCACHE_UNMAP_INVALIDATES,   /* number of regions invalidated because
                                        of unmap events */
+    UCS_RCACHE_UNMAPS_MERGED,       /* number of unmap events merged into
+                                       a pending invalidation */
     UCS_RCACHE_PUTS,                /* number of put operations */
     UCS_RCACHE_REGS,                /* number of memory registrations */
     UCS_RCACHE_DEREGS,              /* number of memory deregistrations */
@@ -105,6 +107,9 @@ struct ucs_rcache {
     UCS_STATS_NODE_DECLARE(stats)
 
     ucs_list_link_t           list; /**< List entry in global ucs_rcache list */
+    ucs_list_link_t           uffd_list; /**< List entry in userfaultfd monitor */
+    int                       uffd; /**< Unmap events come from userfaultfd
+                                         instead of UCM */
     ucs_rcache_distribution_t *distribution; /**< Distribution of registration
                                                   cache regions by size */
 };
@@ -123,6 +128,34 @@ void ucs_rcache_vfs_init(ucs_rcache_t *rcache);
 void ucs_rcache_atfork_disable();
 
 
+/**
+ * Invalidate an unmapped range outside of the unmapping thread context.
+ */
+void ucs_rcache_unmapped_async(ucs_rcache_t *rcache, ucs_pgt_addr_t start,
+                               ucs_pgt_addr_t end);
+
+
+/**
+ * Start receiving unmap events for the rcache from the userfaultfd monitor.
+ */
+ucs_status_t ucs_rcache_uffd_add(ucs_rcache_t *rcache);
+
+
+/**
+ * Stop receiving unmap events for the rcache from the userfaultfd monitor.
+ */
+void ucs_rcache_uffd_remove(ucs_rcache_t *rcache);
+
+
+/**
+ * Request unmap events for a memory range from the userfaultfd monitor.
+ *
+ * @return UCS_OK, or UCS_ERR_UNSUPPORTED if the memory type does not support
+ *         userfaultfd.
+ */
+ucs_status_t ucs_rcache_uffd_register(ucs_pgt_addr_t start, ucs_pgt_addr_t end);
+
+
 /**
  * @brief Get number of bins in the distribution of registration cache region
  *        sizes.
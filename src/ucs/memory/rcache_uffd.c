@@ -0,0 +1,330 @@
+/**
+ * Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+ *
+ * See file LICENSE for terms.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "rcache_int.h"
+
+#include <ucs/async/pipe.h>
+#include <ucs/debug/log.h>
+#include <ucs/sys/compiler.h>
+#include <ucs/sys/math.h>
+#include <ucs/sys/sys.h>
+
+#ifdef HAVE_LINUX_USERFAULTFD_H
+#include <linux/userfaultfd.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <poll.h>
+#endif
+
+
+/*
+ * Unmap notifications from the kernel, used instead of UCM memory hooks.
+ *
+ * Every registered region is also registered with a single process-wide
+ * userfaultfd in write-protect mode. Nothing is ever write-protected, so no
+ * page faults are generated, but the kernel reports munmap(), madvise() and
+ * mremap() of the registered ranges. The unmapping thread is blocked until
+ * the event is read, so the monitor thread must never release memory itself.
+ */
+#if defined(HAVE_LINUX_USERFAULTFD_H) && defined(__NR_userfaultfd) && \
+    defined(UFFD_FEATURE_PAGEFAULT_FLAG_WP) && defined(UFFD_FEATURE_EVENT_UNMAP)
+
+#define UCS_RCACHE_UFFD_FEATURES \
+    (UFFD_FEATURE_EVENT_UNMAP | UFFD_FEATURE_EVENT_REMOVE | \
+     UFFD_FEATURE_EVENT_REMAP)
+
+#define UCS_RCACHE_UFFD_MAX_EVENTS 64
+
+
+typedef struct {
+    /* Serializes starting and stopping the monitor thread */
+    pthread_mutex_t  ctl_lock;
+
+    /* Protects 'list', held by the monitor thread while dispatching events,
+     * so it must never be held while releasing memory */
+    pthread_mutex_t  lock;
+
+    /* Rcaches which get unmap events from the userfaultfd */
+    ucs_list_link_t  list;
+
+    /* Userfaultfd file descriptor, or -1 if not initialized */
+    int              fd;
+
+    /* Process which created the userfaultfd */
+    pid_t            pid;
+
+    /* Used to stop the monitor thread */
+    ucs_async_pipe_t pipe;
+
+    pthread_t        thread;
+} ucs_rcache_uffd_context_t;
+
+
+static ucs_rcache_uffd_context_t ucs_rcache_uffd_context = {
+    .ctl_lock = PTHREAD_MUTEX_INITIALIZER,
+    .lock     = PTHREAD_MUTEX_INITIALIZER,
+    .list     = UCS_LIST_INITIALIZER(&ucs_rcache_uffd_context.list,
+                                     &ucs_rcache_uffd_context.list),
+    .fd       = -1,
+    .pid      = 0,
+    .pipe     = UCS_ASYNC_PIPE_INITIALIZER
+};
+
+
+static void ucs_rcache_uffd_dispatch(ucs_pgt_addr_t start, ucs_pgt_addr_t end)
+{
+    ucs_rcache_t *rcache;
+
+    pthread_mutex_lock(&ucs_rcache_uffd_context.lock);
+    ucs_list_for_each(rcache, &ucs_rcache_uffd_context.list, uffd_list) {
+        ucs_rcache_unmapped_async(rcache, start, end);
+    }
+    pthread_mutex_unlock(&ucs_rcache_uffd_context.lock);
+}
+
+static void ucs_rcache_uffd_wp_fault(ucs_pgt_addr_t address)
+{
+    size_t page_size = ucs_get_page_size();
+    struct uffdio_writeprotect wp;
+
+    /* Should not happen, since no page is write-protected. Just wake up the
+     * faulting thread. */
+    wp.range.start = ucs_align_down_pow2(address, page_size);
+    wp.range.len   = page_size;
+    wp.mode        = 0;
+    if (ioctl(ucs_rcache_uffd_context.fd, UFFDIO_WRITEPROTECT, &wp) < 0) {
+        ucs_warn("UFFDIO_WRITEPROTECT(0x%lx) failed: %m", address);
+    }
+}
+
+static void ucs_rcache_uffd_read_events(void)
+{
+    struct uffd_msg msgs[UCS_RCACHE_UFFD_MAX_EVENTS];
+    ssize_t ret;
+    int i, count;
+
+    for (;;) {
+        ret = read(ucs_rcache_uffd_context.fd, msgs, sizeof(msgs));
+        if (ret < 0) {
+            if ((errno != EAGAIN) && (errno != EINTR)) {
+                ucs_warn("read(userfaultfd) failed: %m");
+            }
+            return;
+        }
+
+        count = ret / sizeof(*msgs);
+        for (i = 0; i < count; ++i) {
+            switch (msgs[i].event) {
+            case UFFD_EVENT_UNMAP:
+            case UFFD_EVENT_REMOVE:
+                ucs_rcache_uffd_dispatch(msgs[i].arg.remove.start,
+                                         msgs[i].arg.remove.end);
+                break;
+            case UFFD_EVENT_REMAP:
+                ucs_rcache_uffd_dispatch(msgs[i].arg.remap.from,
+                                         msgs[i].arg.remap.from +
+                                         msgs[i].arg.remap.len);
+                break;
+            case UFFD_EVENT_PAGEFAULT:
+                ucs_rcache_uffd_wp_fault(msgs[i].arg.pagefault.address);
+                break;
+            default:
+                ucs_debug("unexpected userfaultfd event 0x%x", msgs[i].event);
+                break;
+            }
+        }
+    }
+}
+
+static void *ucs_rcache_uffd_thread_func(void *arg)
+{
+    struct pollfd pfds[2];
+    int ret;
+
+    pfds[0].fd     = ucs_rcache_uffd_context.fd;
+    pfds[0].events = POLLIN;
+    pfds[1].fd     = ucs_async_pipe_rfd(&ucs_rcache_uffd_context.pipe);
+    pfds[1].events = POLLIN;
+
+    for (;;) {
+        ret = poll(pfds, 2, -1);
+        if (ret < 0) {
+            if (errno != EINTR) {
+                ucs_warn("poll(userfaultfd) failed: %m");
+            }
+            continue;
+        }
+
+        if (pfds[0].revents & POLLIN) {
+            ucs_rcache_uffd_read_events();
+        }
+
+        if (pfds[1].revents & POLLIN) {
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+static ucs_status_t ucs_rcache_uffd_open(void)
+{
+    struct uffdio_api api;
+    ucs_status_t status;
+    int fd;
+
+#ifdef UFFD_USER_MODE_ONLY
+    fd = syscall(__NR_userfaultfd,
+                 O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY);
+    if (fd < 0)
+#endif
+    {
+        fd = syscall(__NR_userfaultfd, O_CLOEXEC | O_NONBLOCK);
+    }
+    if (fd < 0) {
+        ucs_debug("userfaultfd() failed: %m");
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    api.api      = UFFD_API;
+    api.features = UCS_RCACHE_UFFD_FEATURES;
+    api.ioctls   = 0;
+    if (ioctl(fd, UFFDIO_API, &api) < 0) {
+        ucs_debug("UFFDIO_API(features=0x%x) failed: %m",
+                  UCS_RCACHE_UFFD_FEATURES);
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close;
+    }
+
+    if (!(api.features & UFFD_FEATURE_PAGEFAULT_FLAG_WP) ||
+        !(api.ioctls & UCS_BIT(_UFFDIO_REGISTER))) {
+        ucs_debug("userfaultfd write-protect mode is not supported");
+        status = UCS_ERR_UNSUPPORTED;
+        goto err_close;
+    }
+
+    status = ucs_async_pipe_create(&ucs_rcache_uffd_context.pipe);
+    if (status != UCS_OK) {
+        goto err_close;
+    }
+
+    ucs_rcache_uffd_context.fd  = fd;
+    ucs_rcache_uffd_context.pid = getpid();
+
+    status = ucs_pthread_create(&ucs_rcache_uffd_context.thread,
+                                ucs_rcache_uffd_thread_func, NULL, "rcache_uffd");
+    if (status != UCS_OK) {
+        goto err_destroy_pipe;
+    }
+
+    ucs_debug("rcache userfaultfd %d monitor started", fd);
+    return UCS_OK;
+
+err_destroy_pipe:
+    ucs_rcache_uffd_context.fd = -1;
+    ucs_async_pipe_destroy(&ucs_rcache_uffd_context.pipe);
+err_close:
+    close(fd);
+    return status;
+}
+
+static void ucs_rcache_uffd_close(void)
+{
+    /* Closing the file descriptor drops all registrations and releases
+     * threads which may be waiting for their events to be read */
+    ucs_async_pipe_push(&ucs_rcache_uffd_context.pipe);
+    pthread_join(ucs_rcache_uffd_context.thread, NULL);
+    ucs_async_pipe_destroy(&ucs_rcache_uffd_context.pipe);
+    close(ucs_rcache_uffd_context.fd);
+    ucs_rcache_uffd_context.fd = -1;
+    ucs_debug("rcache userfaultfd monitor stopped");
+}
+
+ucs_status_t ucs_rcache_uffd_add(ucs_rcache_t *rcache)
+{
+    ucs_status_t status = UCS_OK;
+
+    pthread_mutex_lock(&ucs_rcache_uffd_context.ctl_lock);
+
+    if (ucs_rcache_uffd_context.fd < 0) {
+        status = ucs_rcache_uffd_open();
+        if (status != UCS_OK) {
+            goto out;
+        }
+    } else if (ucs_rcache_uffd_context.pid != getpid()) {
+        /* The monitor thread did not survive fork() */
+        status = UCS_ERR_UNSUPPORTED;
+        goto out;
+    }
+
+    pthread_mutex_lock(&ucs_rcache_uffd_context.lock);
+    ucs_list_add_tail(&ucs_rcache_uffd_context.list, &rcache->uffd_list);
+    pthread_mutex_unlock(&ucs_rcache_uffd_context.lock);
+
+out:
+    pthread_mutex_unlock(&ucs_rcache_uffd_context.ctl_lock);
+    return status;
+}
+
+void ucs_rcache_uffd_remove(ucs_rcache_t *rcache)
+{
+    int empty;
+
+    pthread_mutex_lock(&ucs_rcache_uffd_context.ctl_lock);
+
+    pthread_mutex_lock(&ucs_rcache_uffd_context.lock);
+    ucs_list_del(&rcache->uffd_list);
+    empty = ucs_list_is_empty(&ucs_rcache_uffd_context.list);
+    pthread_mutex_unlock(&ucs_rcache_uffd_context.lock);
+
+    if (empty && (ucs_rcache_uffd_context.pid == getpid())) {
+        ucs_rcache_uffd_close();
+    }
+
+    pthread_mutex_unlock(&ucs_rcache_uffd_context.ctl_lock);
+}
+
+ucs_status_t ucs_rcache_uffd_register(ucs_pgt_addr_t start, ucs_pgt_addr_t end)
+{
+    struct uffdio_register reg;
+
+    if (ucs_rcache_uffd_context.pid != getpid()) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    reg.range.start = start;
+    reg.range.len   = end - start;
+    reg.mode        = UFFDIO_REGISTER_MODE_WP;
+    if (ioctl(ucs_rcache_uffd_context.fd, UFFDIO_REGISTER, &reg) < 0) {
+        /* File-backed mappings do not support write-protect mode */
+        ucs_debug("UFFDIO_REGISTER(0x%lx..0x%lx) failed: %m", start, end);
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    return UCS_OK;
+}
+
+#else
+
+ucs_status_t ucs_rcache_uffd_add(ucs_rcache_t *rcache)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+void ucs_rcache_uffd_remove(ucs_rcache_t *rcache)
+{
+}
+
+ucs_status_t ucs_rcache_uffd_register(ucs_pgt_addr_t start, ucs_pgt_addr_t end)
+{
+    return UCS_ERR_UNSUPPORTED;
+}
+
+#endif
@@ -20,6 +20,20 @@
 #include <errno.h>
 #include <unistd.h>
 #include <sys/epoll.h>
+#include <sys/ioctl.h>
+
+
+#ifndef EPIOCSPARAMS
+/* Busy polling parameters of epoll, supported since Linux 6.9 */
+struct epoll_params {
+    uint32_t busy_poll_usecs;
+    uint16_t busy_poll_budget;
+    uint8_t  prefer_busy_poll;
+    uint8_t  __pad;
+};
+
+#define EPIOCSPARAMS _IOW(0x8A, 0x01, struct epoll_params)
+#endif
 
 
 enum {
@@ -219,6 +233,39 @@ ucs_status_t ucs_event_set_wait(ucs_sys_event_set_t *event_set,
     return UCS_OK;
 }
 
+ucs_status_t ucs_event_set_busy_poll(ucs_sys_event_set_t *event_set,
+                                     unsigned usec, unsigned budget,
+                                     int prefer)
+{
+    struct epoll_params params;
+
+    if ((usec > INT32_MAX) || (budget > UINT16_MAX)) {
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    memset(&params, 0, sizeof(params));
+    params.busy_poll_usecs  = usec;
+    params.busy_poll_budget = budget;
+    params.prefer_busy_poll = !!prefer;
+
+    if (ioctl(event_set->event_fd, EPIOCSPARAMS, &params) < 0) {
+        if ((errno == ENOTTY) || (errno == EINVAL)) {
+            ucs_debug("epoll busy polling is not supported on event_fd=%d: %m",
+                      event_set->event_fd);
+            return UCS_ERR_UNSUPPORTED;
+        }
+
+        ucs_error("ioctl(event_fd=%d, EPIOCSPARAMS, usecs=%u budget=%u "
+                  "prefer=%d) failed: %m", event_set->event_fd, usec, budget,
+                  prefer);
+        return UCS_ERR_IO_ERROR;
+    }
+
+    ucs_trace("event_fd=%d busy polling usecs=%u budget=%u prefer=%d",
+              event_set->event_fd, usec, budget, prefer);
+    return UCS_OK;
+}
+
 void ucs_event_set_cleanup(ucs_sys_event_set_t *event_set)
 {
     if (!(event_set->flags & UCS_SYS_EVENT_SET_EXTERNAL_EVENT_FD)) {
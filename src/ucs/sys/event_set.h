@@ -126,6 +126,26 @@ ucs_status_t ucs_event_set_wait(ucs_sys_event_set_t *event_set,
                                 ucs_event_set_handler_t event_set_handler,
                                 void *arg);
 
+/**
+ * Set busy polling parameters of the event set. When busy polling is enabled,
+ * waiting for events polls the device queues of the sockets in the event set
+ * for up to the given time, instead of relying on device interrupts.
+ *
+ * @param [in] event_set    Event set created by ucs_event_set_create.
+ * @param [in] usec         Busy polling time in microseconds, 0 disables
+ *                          busy polling.
+ * @param [in] budget       Maximal number of packets to process during one
+ *                          busy polling attempt.
+ * @param [in] prefer       Prefer busy polling to interrupts, i.e. defer
+ *                          device interrupts while the event set is polled.
+ *
+ * @return UCS_OK on success, UCS_ERR_UNSUPPORTED if the system does not
+ *         support busy polling of event sets, or an error code on failure.
+ */
+ucs_status_t ucs_event_set_busy_poll(ucs_sys_event_set_t *event_set,
+                                     unsigned usec, unsigned budget,
+                                     int prefer);
+
 /**
  * Cleanup event set
  *
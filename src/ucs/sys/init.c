@@ -114,7 +114,6 @@ void UCS_F_CTOR ucs_init()
     }
 
     ucs_async_global_init();
-    ucs_numa_init();
     ucs_topo_init();
     ucs_rand_seed_init();
     ucs_debug("%s loaded at 0x%lx", ucs_sys_get_lib_path(),
@@ -136,6 +135,7 @@ static void UCS_F_DTOR ucs_cleanup(void)
     ucs_stats_cleanup();
 #endif
     ucs_memtype_cache_cleanup();
+    ucs_sys_vma_cleanup();
     ucs_cleanup_ucm_opts();
     ucs_global_opts_cleanup();
     ucs_log_cleanup();
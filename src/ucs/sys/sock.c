@@ -20,6 +20,7 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <ifaddrs.h>
 #include <unistd.h>
 #include <errno.h>
@@ -665,6 +666,9 @@ ucs_status_t ucs_sockaddr_sizeof(const struct sockaddr *addr, size_t *size_p)
     case AF_INET6:
         *size_p = sizeof(struct sockaddr_in6);
         return UCS_OK;
+    case AF_UNIX:
+        *size_p = sizeof(struct sockaddr_un);
+        return UCS_OK;
     default:
         ucs_error("unknown address family: %d", addr->sa_family);
         return UCS_ERR_INVALID_PARAM;
@@ -757,6 +761,24 @@ int ucs_sockaddr_is_known_af(const struct sockaddr *sa)
             (sa->sa_family == AF_INET6));
 }
 
+static const char *ucs_sockaddr_unix_str(const struct sockaddr_un *sun_addr,
+                                         char *str, size_t max_size)
+{
+    const int path_len = sizeof(sun_addr->sun_path) - 1;
+
+    if (sun_addr->sun_path[0] != '\0') {
+        ucs_snprintf_zero(str, max_size, "%.*s", path_len, sun_addr->sun_path);
+    } else if (sun_addr->sun_path[1] != '\0') {
+        /* Abstract socket address, printed the same way as in /proc/net/unix */
+        ucs_snprintf_zero(str, max_size, "@%.*s", path_len,
+                          sun_addr->sun_path + 1);
+    } else {
+        ucs_strncpy_zero(str, "<unnamed>", max_size);
+    }
+
+    return str;
+}
+
 const char* ucs_sockaddr_str(const struct sockaddr *sock_addr,
                              char *str, size_t max_size)
 {
@@ -768,6 +790,11 @@ const char* ucs_sockaddr_str(const struct sockaddr *sock_addr,
         return str;
     }
 
+    if (sock_addr->sa_family == AF_UNIX) {
+        return ucs_sockaddr_unix_str((const struct sockaddr_un*)sock_addr,
+                                     str, max_size);
+    }
+
     if (!ucs_sockaddr_is_known_af(sock_addr)) {
         ucs_strncpy_zero(str, "<invalid address family>", max_size);
         return str;
@@ -895,6 +922,13 @@ int ucs_sockaddr_cmp(const struct sockaddr *sa1,
     uint16_t port1      = 0, port2 = 0;
     ucs_status_t status = UCS_OK;
 
+    if ((sa1->sa_family == AF_UNIX) && (sa2->sa_family == AF_UNIX)) {
+        result = memcmp(((const struct sockaddr_un*)sa1)->sun_path,
+                        ((const struct sockaddr_un*)sa2)->sun_path,
+                        sizeof(((const struct sockaddr_un*)sa1)->sun_path));
+        goto out;
+    }
+
     if (!ucs_sockaddr_is_known_af(sa1) ||
         !ucs_sockaddr_is_known_af(sa2)) {
         ucs_error("unknown address family: %d",
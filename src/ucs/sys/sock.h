@@ -340,7 +340,8 @@ ucs_status_t ucs_socket_recv(int fd, void *data, size_t length);
  *
  * @param [in]   addr       Pointer to sockaddr structure.
  * @param [out]  size_p     Pointer to variable where size of
- *                          sockaddr_in/sockaddr_in6 structure will be written.
+ *                          sockaddr_in/sockaddr_in6/sockaddr_un structure will
+ *                          be written.
  *
  * @return UCS_OK on success or UCS_ERR_INVALID_PARAM on failure.
  */
@@ -416,6 +417,9 @@ ucs_status_t ucs_sockaddr_inet_addr_sizeof(const struct sockaddr *addr,
  *
  * @return '<null>' if NULL is specified or @a str if the sock_addr has a valid
  *         IP address or 'Invalid address' otherwise.
+ *
+ * @note The path of a UNIX domain socket address is returned instead of the IP
+ *       address, prefixed by '@' for an abstract socket address.
  */
 const char* ucs_sockaddr_str(const struct sockaddr *sock_addr,
                              char *str, size_t max_size);
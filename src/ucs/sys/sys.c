@@ -12,6 +12,8 @@
 
 
 #include <ucs/algorithm/crc.h>
+#include <ucs/arch/cpu.h>
+#include <ucs/config/global_opts.h>
 #include <ucs/sys/checker.h>
 #include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/string.h>
@@ -20,6 +22,7 @@
 #include <ucs/time/time.h>
 #include <ucs/type/init_once.h>
 #include <ucm/util/sys.h>
+#include <ucm/api/ucm.h>
 
 #include <unistd.h>
 #include <sys/stat.h>
@@ -50,6 +53,17 @@
 #define UCS_PROCESS_NS_FIRST       0xF0000000U
 #define UCS_PROCESS_NS_NET_DFLT    0xF0000080U
 #define UCS_DMI_PRODUCT_NAME_FILE  "/sys/devices/virtual/dmi/id/product_name"
+#define UCS_PROCESS_MAPS_FILE      "/proc/self/maps"
+
+/* PROCMAP_QUERY ioctl definitions from linux/fs.h, to allow building with
+ * older kernel headers */
+#define UCS_PROCMAP_QUERY                _IOWR('f', 17, ucs_procmap_query_t)
+#define UCS_PROCMAP_QUERY_VMA_READABLE   0x01
+#define UCS_PROCMAP_QUERY_VMA_WRITABLE   0x02
+#define UCS_PROCMAP_QUERY_VMA_EXECUTABLE 0x04
+
+/* Protection value of VMA cache entries which were invalidated */
+#define UCS_SYS_VMA_PROT_INVALID         -1
 
 #define UCS_NS_INFO_ITEM(_id, _name, _dflt) \
     [_id] = {.name = (_name), .dflt = (_dflt), .value = (_dflt), \
@@ -70,6 +84,71 @@ struct {
     UCS_NS_INFO_ITEM(UCS_SYS_NS_TYPE_UTS,  "uts",  UCS_PROCESS_NS_FIRST - 2)
 };
 
+/* Same layout as struct procmap_query */
+typedef struct {
+    uint64_t size;
+    uint64_t query_flags;
+    uint64_t query_addr;
+    uint64_t vma_start;
+    uint64_t vma_end;
+    uint64_t vma_flags;
+    uint64_t vma_page_size;
+    uint64_t vma_offset;
+    uint64_t inode;
+    uint32_t dev_major;
+    uint32_t dev_minor;
+    uint32_t vma_name_size;
+    uint32_t build_id_size;
+    uint64_t vma_name_addr;
+    uint64_t build_id_addr;
+} ucs_procmap_query_t;
+
+
+typedef struct {
+    unsigned long start;
+    unsigned long end;
+    int           prot; /* PROT_xx flags, or UCS_SYS_VMA_PROT_INVALID */
+} ucs_sys_vma_entry_t;
+
+
+/* File descriptor for PROCMAP_QUERY, reopened after fork */
+static struct {
+    pthread_mutex_t lock;
+    int             fd;
+    pid_t           pid;
+    int             unsupported;
+} ucs_sys_vma_ioctl = {
+    .lock        = PTHREAD_MUTEX_INITIALIZER,
+    .fd          = -1,
+    .pid         = 0,
+    .unsupported = 0
+};
+
+
+/* Sorted table of process memory areas. Entries overlapping mapped or unmapped
+ * ranges are invalidated by memory events, and the whole table is re-read from
+ * /proc/self/maps when a query hits an invalid entry or a hole. */
+static struct {
+    ucs_init_once_t      init_once;
+    pthread_rwlock_t     lock;
+    int                  enabled;  /* Memory events handler is installed */
+    volatile int         valid;    /* Table was not fully invalidated */
+    int                  no_memory;
+    ucs_sys_vma_entry_t  *entries;
+    size_t               count;
+    size_t               capacity;
+} ucs_sys_vma_cache = {
+    .init_once = UCS_INIT_ONCE_INITIALIZER,
+    .lock      = PTHREAD_RWLOCK_INITIALIZER,
+    .enabled   = 0,
+    .valid     = 0,
+    .no_memory = 0,
+    .entries   = NULL,
+    .count     = 0,
+    .capacity  = 0
+};
+
+
 typedef struct {
     void                     *ctx;
     ucs_sys_enum_threads_cb_t cb;
@@ -1055,13 +1134,309 @@ static int ucs_get_mem_prot_cb(void *arg, void *addr, size_t length, int prot,
     return 0;
 }
 
+static int ucs_sys_vma_ioctl_fd()
+{
+    pid_t pid = getpid();
+    int fd;
+
+    if (ucs_likely(ucs_sys_vma_ioctl.pid == pid)) {
+        return ucs_sys_vma_ioctl.fd;
+    }
+
+    pthread_mutex_lock(&ucs_sys_vma_ioctl.lock);
+    if (ucs_sys_vma_ioctl.pid != pid) {
+        /* First use, or the file was opened by the parent process */
+        if (ucs_sys_vma_ioctl.fd >= 0) {
+            close(ucs_sys_vma_ioctl.fd);
+        }
+
+        fd = open(UCS_PROCESS_MAPS_FILE, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            ucs_debug("failed to open %s: %m", UCS_PROCESS_MAPS_FILE);
+        }
+
+        ucs_sys_vma_ioctl.fd = fd;
+        ucs_memory_cpu_store_fence();
+        ucs_sys_vma_ioctl.pid = pid;
+    }
+    pthread_mutex_unlock(&ucs_sys_vma_ioctl.lock);
+
+    return ucs_sys_vma_ioctl.fd;
+}
+
+static ucs_status_t
+ucs_sys_vma_ioctl_get_prot(unsigned long start, unsigned long end, int *prot_p)
+{
+    int prot = PROT_NONE;
+    int found = 0;
+    ucs_procmap_query_t query;
+    int vma_prot, fd;
+
+    if (ucs_sys_vma_ioctl.unsupported) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    fd = ucs_sys_vma_ioctl_fd();
+    if (fd < 0) {
+        return UCS_ERR_IO_ERROR;
+    }
+
+    while (start < end) {
+        memset(&query, 0, sizeof(query));
+        query.size       = sizeof(query);
+        query.query_addr = start;
+        if (ioctl(fd, UCS_PROCMAP_QUERY, &query) < 0) {
+            if (errno == ENOENT) {
+                /* No mapping covers the address */
+                break;
+            } else if ((errno == ENOTTY) || (errno == EINVAL)) {
+                ucs_debug("PROCMAP_QUERY is not supported: %m");
+                ucs_sys_vma_ioctl.unsupported = 1;
+                return UCS_ERR_UNSUPPORTED;
+            }
+
+            ucs_debug("PROCMAP_QUERY(0x%lx) failed: %m", start);
+            return UCS_ERR_IO_ERROR;
+        }
+
+        vma_prot = 0;
+        if (query.vma_flags & UCS_PROCMAP_QUERY_VMA_READABLE) {
+            vma_prot |= PROT_READ;
+        }
+        if (query.vma_flags & UCS_PROCMAP_QUERY_VMA_WRITABLE) {
+            vma_prot |= PROT_WRITE;
+        }
+        if (query.vma_flags & UCS_PROCMAP_QUERY_VMA_EXECUTABLE) {
+            vma_prot |= PROT_EXEC;
+        }
+
+        ucs_trace("range 0x%lx..0x%lx overlaps with mapping 0x%lx..0x%lx "
+                  "prot 0x%x", start, end, (unsigned long)query.vma_start,
+                  (unsigned long)query.vma_end, vma_prot);
+
+        prot  = found ? (prot & vma_prot) : vma_prot;
+        found = 1;
+        start = query.vma_end;
+    }
+
+    *prot_p = prot;
+    return UCS_OK;
+}
+
+/* Returns the index of the first entry which ends after the given address */
+static size_t ucs_sys_vma_cache_search(unsigned long address)
+{
+    size_t low  = 0;
+    size_t high = ucs_sys_vma_cache.count;
+    size_t mid;
+
+    while (low < high) {
+        mid = (low + high) / 2;
+        if (ucs_sys_vma_cache.entries[mid].end <= address) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+static void ucs_sys_vma_cache_event_cb(ucm_event_type_t event_type,
+                                       ucm_event_t *event, void *arg)
+{
+    ucs_sys_vma_entry_t *entry;
+    unsigned long start, end;
+    size_t index;
+
+    if (event_type == UCM_EVENT_VM_MAPPED) {
+        start = (uintptr_t)event->vm_mapped.address;
+        end   = start + event->vm_mapped.size;
+    } else {
+        start = (uintptr_t)event->vm_unmapped.address;
+        end   = start + event->vm_unmapped.size;
+    }
+
+    /* Do not block the memory call. If the lock is taken (possibly by this
+     * thread, when the table is resized), invalidate the whole table. */
+    if (pthread_rwlock_trywrlock(&ucs_sys_vma_cache.lock) != 0) {
+        ucs_sys_vma_cache.valid = 0;
+        return;
+    }
+
+    for (index = ucs_sys_vma_cache_search(start);
+         (index < ucs_sys_vma_cache.count) &&
+         (ucs_sys_vma_cache.entries[index].start < end);
+         ++index) {
+        entry       = &ucs_sys_vma_cache.entries[index];
+        entry->prot = UCS_SYS_VMA_PROT_INVALID;
+    }
+
+    pthread_rwlock_unlock(&ucs_sys_vma_cache.lock);
+}
+
+static int ucs_sys_vma_cache_add_cb(void *arg, void *addr, size_t length,
+                                    int prot, const char *path)
+{
+    ucs_sys_vma_entry_t *entries, *entry;
+    size_t capacity;
+
+    if (ucs_sys_vma_cache.count == ucs_sys_vma_cache.capacity) {
+        capacity = ucs_max(ucs_sys_vma_cache.capacity * 2, 256);
+        entries  = ucs_realloc(ucs_sys_vma_cache.entries,
+                               capacity * sizeof(*entries), "vma_cache");
+        if (entries == NULL) {
+            ucs_sys_vma_cache.no_memory = 1;
+            return 1;
+        }
+
+        ucs_sys_vma_cache.entries  = entries;
+        ucs_sys_vma_cache.capacity = capacity;
+    }
+
+    entry        = &ucs_sys_vma_cache.entries[ucs_sys_vma_cache.count++];
+    entry->start = (uintptr_t)addr;
+    entry->end   = (uintptr_t)addr + length;
+    entry->prot  = prot;
+    return 0;
+}
+
+/* Called with the lock held for writing */
+static ucs_status_t ucs_sys_vma_cache_rebuild()
+{
+    /* Memory events from now on, including the ones caused by growing the
+     * table, will invalidate the table again */
+    ucs_sys_vma_cache.valid     = 1;
+    ucs_sys_vma_cache.no_memory = 0;
+    ucs_sys_vma_cache.count     = 0;
+    ucs_memory_cpu_fence();
+
+    ucm_parse_proc_self_maps(ucs_sys_vma_cache_add_cb, NULL);
+    if (ucs_sys_vma_cache.no_memory) {
+        ucs_sys_vma_cache.valid = 0;
+        ucs_sys_vma_cache.count = 0;
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    return UCS_OK;
+}
+
+/*
+ * Returns 1 if the range was resolved. A hole in the range is considered a
+ * miss unless the table was just rebuilt, since memory could be mapped by a
+ * call which did not generate a memory event.
+ */
+static int ucs_sys_vma_cache_lookup(unsigned long start, unsigned long end,
+                                    int rebuilt, int *prot_p)
+{
+    int prot  = PROT_NONE;
+    int found = 0;
+    const ucs_sys_vma_entry_t *entry;
+    size_t index;
+
+    for (index = ucs_sys_vma_cache_search(start);
+         index < ucs_sys_vma_cache.count; ++index) {
+        entry = &ucs_sys_vma_cache.entries[index];
+        if (start < entry->start) {
+            break;
+        } else if (entry->prot == UCS_SYS_VMA_PROT_INVALID) {
+            return 0;
+        }
+
+        prot  = found ? (prot & entry->prot) : entry->prot;
+        found = 1;
+        if (end <= entry->end) {
+            *prot_p = prot;
+            return 1;
+        }
+
+        start = entry->end;
+    }
+
+    *prot_p = prot;
+    return rebuilt;
+}
+
+static ucs_status_t
+ucs_sys_vma_cache_get_prot(unsigned long start, unsigned long end, int *prot_p)
+{
+    ucs_status_t status;
+    int found;
+
+    UCS_INIT_ONCE(&ucs_sys_vma_cache.init_once) {
+        status = ucm_set_event_handler(UCM_EVENT_VM_MAPPED |
+                                       UCM_EVENT_VM_UNMAPPED,
+                                       1000, ucs_sys_vma_cache_event_cb, NULL);
+        if (status != UCS_OK) {
+            ucs_debug("failed to set VMA cache event handler: %s",
+                      ucs_status_string(status));
+        }
+
+        ucs_sys_vma_cache.enabled = (status == UCS_OK);
+    }
+
+    if (!ucs_sys_vma_cache.enabled) {
+        return UCS_ERR_UNSUPPORTED;
+    }
+
+    pthread_rwlock_rdlock(&ucs_sys_vma_cache.lock);
+    found = ucs_sys_vma_cache.valid &&
+            ucs_sys_vma_cache_lookup(start, end, 0, prot_p);
+    pthread_rwlock_unlock(&ucs_sys_vma_cache.lock);
+    if (found) {
+        return UCS_OK;
+    }
+
+    pthread_rwlock_wrlock(&ucs_sys_vma_cache.lock);
+    status = ucs_sys_vma_cache_rebuild();
+    if (status == UCS_OK) {
+        ucs_sys_vma_cache_lookup(start, end, 1, prot_p);
+    }
+    pthread_rwlock_unlock(&ucs_sys_vma_cache.lock);
+
+    return status;
+}
+
 int ucs_get_mem_prot(unsigned long start, unsigned long end)
 {
+    ucs_vma_query_t method     = ucs_global_opts.vma_query;
     ucs_get_mem_prot_ctx_t ctx = { start, end, PROT_NONE, 0 };
+    int prot                   = PROT_NONE;
+
+    if (((method == UCS_VMA_QUERY_AUTO) || (method == UCS_VMA_QUERY_IOCTL)) &&
+        (ucs_sys_vma_ioctl_get_prot(start, end, &prot) == UCS_OK)) {
+        return prot;
+    }
+
+    if (((method == UCS_VMA_QUERY_AUTO) || (method == UCS_VMA_QUERY_CACHE)) &&
+        (ucs_sys_vma_cache_get_prot(start, end, &prot) == UCS_OK)) {
+        return prot;
+    }
+
     ucm_parse_proc_self_maps(ucs_get_mem_prot_cb, &ctx);
     return ctx.prot;
 }
 
+void ucs_sys_vma_cleanup()
+{
+    if (ucs_sys_vma_cache.enabled) {
+        ucm_unset_event_handler(UCM_EVENT_VM_MAPPED | UCM_EVENT_VM_UNMAPPED,
+                                ucs_sys_vma_cache_event_cb, NULL);
+        ucs_sys_vma_cache.enabled = 0;
+    }
+
+    ucs_free(ucs_sys_vma_cache.entries);
+    ucs_sys_vma_cache.entries  = NULL;
+    ucs_sys_vma_cache.count    = 0;
+    ucs_sys_vma_cache.capacity = 0;
+
+    if ((ucs_sys_vma_ioctl.fd >= 0) && (ucs_sys_vma_ioctl.pid == getpid())) {
+        close(ucs_sys_vma_ioctl.fd);
+    }
+    ucs_sys_vma_ioctl.fd  = -1;
+    ucs_sys_vma_ioctl.pid = 0;
+}
+
 const char* ucs_get_process_cmdline()
 {
     static char cmdline[1024] = {0};
@@ -407,6 +407,12 @@ ucs_status_t ucs_mmap_free(void *address, size_t length);
 int ucs_get_mem_prot(unsigned long start, unsigned long end);
 
 
+/**
+ * Release resources used to query memory protection.
+ */
+void ucs_sys_vma_cleanup();
+
+
 /**
  * Returns the physical page frame number of a given virtual page address.
  * If the page map file is non-readable (for example, due to permissions), or
@@ -8,6 +8,7 @@
 #  include "config.h"
 #endif
 
+#include <ucs/arch/cpu.h>
 #include <ucs/memory/numa.h>
 #include <ucs/sys/math.h>
 #include <ucs/sys/topo/base/topo.h>
@@ -68,10 +69,13 @@ typedef struct {
 typedef int64_t ucs_bus_id_bit_rep_t;
 
 typedef struct {
-    ucs_sys_bus_id_t bus_id;
-    char             *name;
-    unsigned         name_priority;
-    ucs_numa_node_t  numa_node;
+    ucs_sys_bus_id_t       bus_id;
+    char                   *name;
+    unsigned               name_priority;
+    ucs_numa_node_t        numa_node;
+    char                   *sysfs_path; /* Resolved sysfs path, or NULL */
+    ucs_sys_dev_distance_t *distances;  /* Distance to every other device,
+                                           indexed by device id, or NULL */
 } ucs_topo_sys_device_info_t;
 
 KHASH_MAP_INIT_INT64(bus_to_sys_dev, ucs_sys_device_t);
@@ -80,7 +84,9 @@ typedef struct ucs_topo_global_ctx {
     ucs_spinlock_t             lock;
     khash_t(bus_to_sys_dev)    bus_to_sys_dev_hash;
     ucs_topo_sys_device_info_t devices[UCS_TOPO_MAX_SYS_DEVICES];
-    unsigned                   num_devices;
+    /* Device entries below this number are completely initialized and are
+     * never changed, except their name, so they can be read without locking */
+    volatile unsigned          num_devices;
 } ucs_topo_global_ctx_t;
 
 
@@ -223,18 +229,50 @@ ucs_topo_bus_id_to_sysfs_path(const ucs_sys_bus_id_t *bus_id, char *path,
     return UCS_OK;
 }
 
-static int
-ucs_topo_read_device_numa_node(const ucs_sys_bus_id_t *bus_id)
+static void ucs_topo_read_device_info(ucs_topo_sys_device_info_t *device)
 {
     char path[PATH_MAX];
     ucs_status_t status;
 
-    status = ucs_topo_bus_id_to_sysfs_path(bus_id, path, sizeof(path));
+    status = ucs_topo_bus_id_to_sysfs_path(&device->bus_id, path, sizeof(path));
     if (status != UCS_OK) {
-        return UCS_NUMA_NODE_UNDEFINED;
+        device->sysfs_path = NULL;
+        device->numa_node  = UCS_NUMA_NODE_UNDEFINED;
+        return;
+    }
+
+    device->sysfs_path = ucs_strdup(path, "sys_dev_sysfs_path");
+    device->numa_node  = ucs_numa_node_of_device(path);
+}
+
+static void ucs_topo_sysfs_distance_calc(const ucs_topo_sys_device_info_t *device1,
+                                         const ucs_topo_sys_device_info_t *device2,
+                                         ucs_sys_dev_distance_t *distance);
+
+/* Called with lock held, before the device is published */
+static void ucs_topo_init_device_distances(ucs_sys_device_t sys_dev)
+{
+    ucs_topo_sys_device_info_t *device = &ucs_topo_global_ctx.devices[sys_dev];
+    ucs_topo_sys_device_info_t *peer;
+    ucs_sys_device_t peer_sys_dev;
+
+    device->distances = ucs_calloc(UCS_TOPO_MAX_SYS_DEVICES,
+                                   sizeof(*device->distances),
+                                   "sys_dev_distances");
+    if (device->distances == NULL) {
+        ucs_debug("failed to allocate distances of sys_dev %d", sys_dev);
+        return;
     }
 
-    return ucs_numa_node_of_device(path);
+    device->distances[sys_dev] = ucs_topo_default_distance;
+    for (peer_sys_dev = 0; peer_sys_dev < sys_dev; ++peer_sys_dev) {
+        peer = &ucs_topo_global_ctx.devices[peer_sys_dev];
+        ucs_topo_sysfs_distance_calc(device, peer,
+                                     &device->distances[peer_sys_dev]);
+        if (peer->distances != NULL) {
+            peer->distances[sys_dev] = device->distances[peer_sys_dev];
+        }
+    }
 }
 
 ucs_status_t ucs_topo_find_device_by_bus_id(const ucs_sys_bus_id_t *bus_id,
@@ -260,7 +298,6 @@ ucs_status_t ucs_topo_find_device_by_bus_id(const ucs_sys_bus_id_t *bus_id,
         ucs_assert_always(ucs_topo_global_ctx.num_devices <
                           UCS_TOPO_MAX_SYS_DEVICES);
         *sys_dev = ucs_topo_global_ctx.num_devices;
-        ++ucs_topo_global_ctx.num_devices;
 
         kh_value(&ucs_topo_global_ctx.bus_to_sys_dev_hash, hash_it) = *sys_dev;
 
@@ -273,8 +310,12 @@ ucs_status_t ucs_topo_find_device_by_bus_id(const ucs_sys_bus_id_t *bus_id,
         ucs_topo_global_ctx.devices[*sys_dev].bus_id        = *bus_id;
         ucs_topo_global_ctx.devices[*sys_dev].name          = name;
         ucs_topo_global_ctx.devices[*sys_dev].name_priority = 0;
-        ucs_topo_global_ctx.devices[*sys_dev].numa_node     =
-                ucs_topo_read_device_numa_node(bus_id);
+        ucs_topo_read_device_info(&ucs_topo_global_ctx.devices[*sys_dev]);
+        ucs_topo_init_device_distances(*sys_dev);
+
+        /* Publish the device only after it is completely initialized */
+        ucs_memory_cpu_store_fence();
+        ucs_topo_global_ctx.num_devices = *sys_dev + 1;
         ucs_debug("added sys_dev %d for bus id %s", *sys_dev, name);
     }
 
@@ -293,33 +334,6 @@ ucs_status_t ucs_topo_get_device_bus_id(ucs_sys_device_t sys_dev,
     return UCS_OK;
 }
 
-static ucs_status_t
-ucs_topo_sys_dev_to_sysfs_path(ucs_sys_device_t sys_dev, char *path, size_t max)
-{
-    ucs_status_t status;
-
-    ucs_spin_lock(&ucs_topo_global_ctx.lock);
-
-    if (sys_dev >= ucs_topo_global_ctx.num_devices) {
-        ucs_error("system device %d is invalid (max: %d)", sys_dev,
-                  ucs_topo_global_ctx.num_devices);
-        status = UCS_ERR_INVALID_PARAM;
-        goto out_unlock;
-    }
-
-    status = ucs_topo_bus_id_to_sysfs_path(
-            &ucs_topo_global_ctx.devices[sys_dev].bus_id, path, max);
-    if (status != UCS_OK) {
-        goto out_unlock;
-    }
-
-    status = UCS_OK;
-
-out_unlock:
-    ucs_spin_unlock(&ucs_topo_global_ctx.lock);
-    return status;
-}
-
 static int ucs_topo_is_sys_root(const char *path)
 {
     return !strcmp(path, UCS_TOPO_SYSFS_DEVICES_ROOT);
@@ -369,13 +383,44 @@ static void ucs_topo_common_numa_node_distance(ucs_sys_dev_distance_t *distance)
 }
 
 static int
-ucs_topo_is_same_numa_node(ucs_sys_device_t device1,
-                             ucs_sys_device_t device2)
+ucs_topo_is_same_numa_node(const ucs_topo_sys_device_info_t *device1,
+                           const ucs_topo_sys_device_info_t *device2)
 {
-    ucs_numa_node_t numa1 = ucs_topo_sys_device_get_numa_node(device1);
-    ucs_numa_node_t numa2 = ucs_topo_sys_device_get_numa_node(device2);
+    return (device1->numa_node == device2->numa_node) &&
+           (device1->numa_node != UCS_SYS_DEVICE_ID_UNKNOWN);
+}
+
+static void ucs_topo_sysfs_distance_calc(const ucs_topo_sys_device_info_t *device1,
+                                         const ucs_topo_sys_device_info_t *device2,
+                                         ucs_sys_dev_distance_t *distance)
+{
+    char common_path[PATH_MAX];
+
+    if ((device1->sysfs_path == NULL) || (device2->sysfs_path == NULL)) {
+        ucs_debug("failed to get sysfs path for %s or %s", device1->name,
+                  device2->name);
+        goto default_distance;
+    }
 
-    return (numa1 == numa2) && (numa1 != UCS_SYS_DEVICE_ID_UNKNOWN);
+    ucs_path_get_common_parent(device1->sysfs_path, device2->sysfs_path,
+                               common_path);
+    if (ucs_topo_is_pci_root(common_path)) {
+        ucs_topo_pci_root_distance(device1->sysfs_path, device2->sysfs_path,
+                                   distance);
+        return;
+    } else if (ucs_topo_is_sys_root(common_path)) {
+        if (ucs_topo_is_same_numa_node(device1, device2)) {
+            ucs_topo_common_numa_node_distance(distance);
+            return;
+        }
+
+        ucs_topo_sys_root_distance(distance);
+        return;
+    }
+
+    /* Report best perf for common PCI bridge or sysfs parsing error */
+default_distance:
+    *distance = ucs_topo_default_distance;
 }
 
 static ucs_status_t
@@ -383,8 +428,8 @@ ucs_topo_get_distance_sysfs(ucs_sys_device_t device1,
                             ucs_sys_device_t device2,
                             ucs_sys_dev_distance_t *distance)
 {
-    char path1[PATH_MAX], path2[PATH_MAX], common_path[PATH_MAX];
-    ucs_status_t status;
+    const ucs_topo_sys_device_info_t *device_info1, *device_info2;
+    unsigned num_devices;
 
     /* If one of the devices is unknown, we assume near topology */
     if ((device1 == UCS_SYS_DEVICE_ID_UNKNOWN) ||
@@ -392,35 +437,24 @@ ucs_topo_get_distance_sysfs(ucs_sys_device_t device1,
         goto default_distance;
     }
 
-    status = ucs_topo_sys_dev_to_sysfs_path(device1, path1, sizeof(path1));
-    if (status != UCS_OK) {
-        ucs_debug("failed to get sysfs path for %s",
-                  ucs_topo_sys_device_get_name(device1));
+    num_devices = ucs_topo_global_ctx.num_devices;
+    if ((device1 >= num_devices) || (device2 >= num_devices)) {
+        ucs_error("system device %d or %d is invalid (max: %d)", device1,
+                  device2, num_devices);
         goto default_distance;
     }
 
-    status = ucs_topo_sys_dev_to_sysfs_path(device2, path2, sizeof(path2));
-    if (status != UCS_OK) {
-        ucs_debug("failed to get sysfs path for %s",
-                  ucs_topo_sys_device_get_name(device2));
-        goto default_distance;
+    ucs_memory_cpu_load_fence();
+    device_info1 = &ucs_topo_global_ctx.devices[device1];
+    device_info2 = &ucs_topo_global_ctx.devices[device2];
+    if (device_info1->distances != NULL) {
+        *distance = device_info1->distances[device2];
+    } else {
+        ucs_topo_sysfs_distance_calc(device_info1, device_info2, distance);
     }
 
-    ucs_path_get_common_parent(path1, path2, common_path);
-    if (ucs_topo_is_pci_root(common_path)) {
-        ucs_topo_pci_root_distance(path1, path2, distance);
-        return UCS_OK;
-    } else if (ucs_topo_is_sys_root(common_path)) {
-        if (ucs_topo_is_same_numa_node(device1, device2)) {
-            ucs_topo_common_numa_node_distance(distance);
-            return UCS_OK;
-        }
-
-        ucs_topo_sys_root_distance(distance);
-        return UCS_OK;
-    }
+    return UCS_OK;
 
-    /* Report best perf for common PCI bridge or sysfs parsing error */
 default_distance:
     return ucs_topo_get_distance_default(device1, device2, distance);
 }
@@ -614,21 +648,13 @@ const char *ucs_topo_sys_device_get_name(ucs_sys_device_t sys_dev)
 
 ucs_numa_node_t ucs_topo_sys_device_get_numa_node(ucs_sys_device_t sys_dev)
 {
-    int numa_node;
-
-    if (sys_dev == UCS_SYS_DEVICE_ID_UNKNOWN) {
+    if ((sys_dev == UCS_SYS_DEVICE_ID_UNKNOWN) ||
+        (sys_dev >= ucs_topo_global_ctx.num_devices)) {
         return UCS_NUMA_NODE_UNDEFINED;
     }
 
-    ucs_spin_lock(&ucs_topo_global_ctx.lock);
-    if (sys_dev < ucs_topo_global_ctx.num_devices) {
-        numa_node = ucs_topo_global_ctx.devices[sys_dev].numa_node;
-    } else {
-        numa_node = UCS_NUMA_NODE_UNDEFINED;
-    }
-    ucs_spin_unlock(&ucs_topo_global_ctx.lock);
-
-    return numa_node;
+    ucs_memory_cpu_load_fence();
+    return ucs_topo_global_ctx.devices[sys_dev].numa_node;
 }
 
 void ucs_topo_print_info(FILE *stream)
@@ -672,6 +698,8 @@ void ucs_topo_cleanup()
 
     while (ucs_topo_global_ctx.num_devices-- > 0) {
         device = &ucs_topo_global_ctx.devices[ucs_topo_global_ctx.num_devices];
+        ucs_free(device->distances);
+        ucs_free(device->sysfs_path);
         ucs_free(device->name);
     }
 
@@ -579,7 +579,7 @@ enum uct_msg_flags {
  */
 enum uct_cb_flags {
     UCT_CB_FLAG_RESERVED = UCS_BIT(1), /**< Reserved for future use. */
-    UCT_CB_FLAG_ASYNC    = UCS_BIT(2)  /**< Callback is allowed to be called
+    UCT_CB_FLAG_ASYNC    = UCS_BIT(2), /**< Callback is allowed to be called
                                             from any thread in the process, and
                                             therefore should be thread-safe. For
                                             example, it may be called from a
@@ -594,6 +594,15 @@ enum uct_cb_flags {
                                             the callback will be invoked only
                                             from the context that called @ref
                                             uct_iface_progress). */
+    UCT_CB_FLAG_PRIORITY = UCS_BIT(3)  /**< Applicable only to
+                                            @ref uct_ep_pending_add. The pending
+                                            request is latency-sensitive, such
+                                            as a control message, and should be
+                                            dispatched before other pending
+                                            requests which were not added with
+                                            this flag. Transports which do not
+                                            support pending priorities ignore
+                                            this flag. */
 };
 
 
@@ -2273,6 +2282,32 @@ ucs_status_t uct_iface_set_am_handler(uct_iface_h iface, uint8_t id,
                                       uct_am_callback_t cb, void *arg, uint32_t flags);
 
 
+/**
+ * @ingroup UCT_AM
+ * @brief Set a callback to place the payload of active messages to user buffers.
+ *
+ * The callback allows transports which receive large active messages in parts
+ * to receive the payload directly to a buffer provided by the user, instead
+ * of copying it from a transport buffer. The active message handler of
+ * @a id must support @ref UCT_CB_PARAM_FLAG_RECV_INTO flag. Setting the active
+ * message handler by @ref uct_iface_set_am_handler clears the callback.
+ * Transports which do not support this method ignore the callback.
+ *
+ * @param [in]  iface       Interface to set the callback for.
+ * @param [in]  id          Active message id. Must be 0..UCT_AM_ID_MAX-1.
+ * @param [in]  cb          Callback which provides a buffer for the payload.
+ *                          NULL to clear.
+ * @param [in]  arg         Callback argument.
+ * @param [in]  hdr_length  Length of the header of the active message which
+ *                          is passed to the callback.
+ *
+ * @return error code if the active message id is invalid.
+ */
+ucs_status_t uct_iface_set_am_recv_into_handler(uct_iface_h iface, uint8_t id,
+                                                uct_am_recv_into_callback_t cb,
+                                                void *arg, size_t hdr_length);
+
+
 /**
  * @ingroup UCT_AM
  * @brief Set active message tracer for the interface.
@@ -64,11 +64,17 @@ enum uct_am_trace_type {
  * @ref uct_tag_unexp_eager_cb_t callback only. The former value indicates that
  * the data is the first fragment of the message. The latter value means that
  * more fragments of the message yet to be delivered.
+ *
+ * UCT_CB_PARAM_FLAG_RECV_INTO flag is relevant for @ref uct_am_callback_t
+ * callback only. It indicates that the payload of the active message was
+ * placed to the buffer returned by @ref uct_am_recv_into_callback_t, and
+ * only the header of the message is available in the data.
  */
 enum uct_cb_param_flags {
-    UCT_CB_PARAM_FLAG_DESC  = UCS_BIT(0),
-    UCT_CB_PARAM_FLAG_FIRST = UCS_BIT(1),
-    UCT_CB_PARAM_FLAG_MORE  = UCS_BIT(2)
+    UCT_CB_PARAM_FLAG_DESC      = UCS_BIT(0),
+    UCT_CB_PARAM_FLAG_FIRST     = UCS_BIT(1),
+    UCT_CB_PARAM_FLAG_MORE      = UCS_BIT(2),
+    UCT_CB_PARAM_FLAG_RECV_INTO = UCS_BIT(3)
 };
 
 /**
@@ -507,6 +513,34 @@ typedef ucs_status_t (*uct_am_callback_t)(void *arg, void *data, size_t length,
                                           unsigned flags);
 
 
+/**
+ * @ingroup UCT_AM
+ * @brief Callback to provide a buffer for the payload of an active message
+ *
+ * The callback may be invoked by transports which receive an active message
+ * in parts, when the header of the message has arrived and the rest of it is
+ * still in flight. If the callback returns a buffer, the transport places the
+ * payload of the message directly to that buffer, and then invokes the active
+ * message callback with @ref UCT_CB_PARAM_FLAG_RECV_INTO flag. Otherwise, the
+ * message is received and delivered as usual.
+ *
+ * @param [in]  arg      User-defined argument.
+ * @param [in]  data     Points to the header of the message, which is
+ *                       @a hdr_length bytes passed to
+ *                       @ref uct_iface_set_am_recv_into_handler.
+ * @param [in]  length   Length of the whole message, including the header.
+ *
+ * @note The callback is always invoked from the context (thread, process)
+ *       that called @a uct_iface_progress(), and it must not call other
+ *       communication routines.
+ *
+ * @return Buffer of (@a length - hdr_length) bytes to receive the payload to,
+ *         or NULL to receive the message as usual.
+ */
+typedef void* (*uct_am_recv_into_callback_t)(void *arg, const void *data,
+                                             size_t length);
+
+
 /**
  * @ingroup UCT_AM
  * @brief Callback to trace active messages.
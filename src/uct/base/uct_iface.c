@@ -97,11 +97,20 @@ static ucs_status_t uct_iface_stub_am_handler(void *arg, void *data,
     return UCS_OK;
 }
 
+static void uct_iface_clear_am_recv_into_handler(uct_base_iface_t *iface,
+                                                 uint8_t id)
+{
+    iface->am[id].recv_into_cb         = NULL;
+    iface->am[id].recv_into_arg        = NULL;
+    iface->am[id].recv_into_hdr_length = 0;
+}
+
 static void uct_iface_set_stub_am_handler(uct_base_iface_t *iface, uint8_t id)
 {
     iface->am[id].cb    = uct_iface_stub_am_handler;
     iface->am[id].arg   = (void*)(uintptr_t)id;
     iface->am[id].flags = UCT_CB_FLAG_ASYNC;
+    uct_iface_clear_am_recv_into_handler(iface, id);
 }
 
 ucs_status_t uct_iface_set_am_handler(uct_iface_h tl_iface, uint8_t id,
@@ -141,6 +150,31 @@ ucs_status_t uct_iface_set_am_handler(uct_iface_h tl_iface, uint8_t id,
     iface->am[id].cb    = cb;
     iface->am[id].arg   = arg;
     iface->am[id].flags = flags;
+    uct_iface_clear_am_recv_into_handler(iface, id);
+    return UCS_OK;
+}
+
+ucs_status_t uct_iface_set_am_recv_into_handler(uct_iface_h tl_iface,
+                                                uint8_t id,
+                                                uct_am_recv_into_callback_t cb,
+                                                void *arg, size_t hdr_length)
+{
+    uct_base_iface_t *iface = ucs_derived_of(tl_iface, uct_base_iface_t);
+
+    if (id >= UCT_AM_ID_MAX) {
+        ucs_error("active message id out-of-range (got: %d max: %d)", id,
+                  (int)UCT_AM_ID_MAX);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if (cb == NULL) {
+        uct_iface_clear_am_recv_into_handler(iface, id);
+        return UCS_OK;
+    }
+
+    iface->am[id].recv_into_cb         = cb;
+    iface->am[id].recv_into_arg        = arg;
+    iface->am[id].recv_into_hdr_length = hdr_length;
     return UCS_OK;
 }
 
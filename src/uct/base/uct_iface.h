@@ -261,9 +261,12 @@ UCS_CLASS_DECLARE(uct_ep_t, uct_iface_h);
  * Active message handle table entry
  */
 typedef struct uct_am_handler {
-    uct_am_callback_t cb;
-    void              *arg;
-    uint32_t          flags;
+    uct_am_callback_t           cb;
+    void                        *arg;
+    uint32_t                    flags;
+    uct_am_recv_into_callback_t recv_into_cb;
+    void                        *recv_into_arg;
+    size_t                      recv_into_hdr_length;
 } uct_am_handler_t;
 
 
@@ -656,13 +659,19 @@ uct_pending_req_priv_arb_elem(uct_pending_req_t *req)
 
 
 /**
- * Add a pending request to the arbiter.
+ * Add a pending request to the arbiter. If @ref UCT_CB_FLAG_PRIORITY is set in
+ * _flags, the request is added before non-priority requests of the group.
  */
-#define uct_pending_req_arb_group_push(_arbiter_group, _req) \
+#define uct_pending_req_arb_group_push(_arbiter_group, _req, _flags) \
     do { \
         ucs_arbiter_elem_init(uct_pending_req_priv_arb_elem(_req)); \
-        ucs_arbiter_group_push_elem_always(_arbiter_group, \
-                                           uct_pending_req_priv_arb_elem(_req)); \
+        if ((_flags) & UCT_CB_FLAG_PRIORITY) { \
+            ucs_arbiter_group_push_prio_elem_always( \
+                    _arbiter_group, uct_pending_req_priv_arb_elem(_req)); \
+        } else { \
+            ucs_arbiter_group_push_elem_always( \
+                    _arbiter_group, uct_pending_req_priv_arb_elem(_req)); \
+        } \
     } while (0)
 
 
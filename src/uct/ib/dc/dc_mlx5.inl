@@ -75,7 +75,7 @@ uct_dc_mlx5_ep_pending_common(uct_dc_mlx5_iface_t *iface, uct_dc_mlx5_ep_t *ep,
     if (push_to_head) {
         uct_pending_req_arb_group_push_head(group, r);
     } else {
-        uct_pending_req_arb_group_push(group, r);
+        uct_pending_req_arb_group_push(group, r, flags);
     }
 
     UCT_TL_EP_STAT_PEND(&ep->super);
@@ -1712,7 +1712,7 @@ add_req:
                       UCT_PENDING_REQ_PRIV_LEN);
     uct_ud_pending_req_priv(req)->flags = flags;
     uct_ud_ep_set_has_pending_flag(ep);
-    uct_pending_req_arb_group_push(&ep->tx.pending.group, req);
+    uct_pending_req_arb_group_push(&ep->tx.pending.group, req, flags);
     ucs_arbiter_group_schedule(&iface->tx.pending_q, &ep->tx.pending.group);
     ucs_trace_data("ud ep %p: added pending req %p tx_psn %d acked_psn %d cwnd %d",
                    ep, req, ep->tx.psn, ep->tx.acked_psn, ep->ca.cwnd);
@@ -20,11 +20,20 @@
 #include <ucs/sys/iovec.h>
 
 #include <net/if.h>
+#include <sys/un.h>
 
 #define UCT_TCP_NAME                          "tcp"
 
 #define UCT_TCP_CONFIG_PREFIX                 "TCP_"
 
+/* Name of the device which uses UNIX domain sockets for intra-node
+ * connections */
+#define UCT_TCP_UNIX_DEV_NAME                 "unix"
+
+/* Name of the abstract UNIX domain socket of an iface, which is followed by
+ * the port of the iface */
+#define UCT_TCP_UNIX_SOCKET_NAME_FMT          "ucx-tcp-%hu"
+
 /* Magic number that is used by TCP to identify its peers */
 #define UCT_TCP_MAGIC_NUMBER                  0xCAFEBABE12345678lu
 
@@ -47,6 +56,10 @@
  * operation */
 #define UCT_TCP_EP_PUT_ZCOPY_MAX              SIZE_MAX
 
+/* Maximum size of a data that can be received by GET Zcopy
+ * operation */
+#define UCT_TCP_EP_GET_ZCOPY_MAX              SIZE_MAX
+
 /* Length of a data that is used by PUT protocol */
 #define UCT_TCP_EP_PUT_SERVICE_LENGTH        (sizeof(uct_tcp_am_hdr_t) + \
                                               sizeof(uct_tcp_ep_put_req_hdr_t))
@@ -114,7 +127,13 @@ enum {
     /* EP is on EP PTR map. */
     UCT_TCP_EP_FLAG_ON_PTR_MAP         = UCS_BIT(9),
     /* EP has some operations done without flush */
-    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10)
+    UCT_TCP_EP_FLAG_NEED_FLUSH         = UCS_BIT(10),
+    /* GET RX operation is in progress on a given EP, i.e. GET reply data
+     * is being received to a user's buffer. */
+    UCT_TCP_EP_FLAG_GET_RX             = UCS_BIT(11),
+    /* The payload of an AM is being received to a user's buffer on a
+     * given EP. */
+    UCT_TCP_EP_FLAG_AM_RX_INTO         = UCS_BIT(12)
 };
 
 
@@ -225,7 +244,11 @@ typedef enum uct_tcp_ep_am_id {
     /* AM ID reserved for TCP internal PUT ACK message */
     UCT_TCP_EP_PUT_ACK_AM_ID   = UCT_AM_ID_MAX + 2,
     /* AM ID reserved for TCP internal keepalive message */
-    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3
+    UCT_TCP_EP_KEEPALIVE_AM_ID = UCT_AM_ID_MAX + 3,
+    /* AM ID reserved for TCP internal GET REQ message */
+    UCT_TCP_EP_GET_REQ_AM_ID   = UCT_AM_ID_MAX + 4,
+    /* AM ID reserved for TCP internal GET REP message */
+    UCT_TCP_EP_GET_REP_AM_ID   = UCT_AM_ID_MAX + 5
 } uct_tcp_ep_am_id_t;
 
 
@@ -239,6 +262,30 @@ typedef struct uct_tcp_ep_put_req_hdr {
 } UCS_S_PACKED uct_tcp_ep_put_req_hdr_t;
 
 
+/**
+ * State of an AM which payload is being received to a user's buffer, it is
+ * followed by the TCP AM header and the user's AM header
+ */
+typedef struct uct_tcp_ep_am_rx_into_hdr {
+    uint64_t                      addr;        /* Address to receive the rest of the payload to */
+    size_t                        length;      /* Length of the rest of the payload */
+} UCS_S_PACKED uct_tcp_ep_am_rx_into_hdr_t;
+
+
+/* Maximal length of the user's AM header which allows receiving the payload
+ * of the AM to a user's buffer */
+#define UCT_TCP_EP_AM_RX_INTO_HDR_MAX        32
+
+
+/* Size of an EP RX buffer which keeps a partially received AM header, the
+ * magic number, a PUT request or an AM which payload is being received to
+ * a user's buffer */
+#define UCT_TCP_EP_RX_HDR_BUF_SIZE \
+    ucs_max(sizeof(uct_tcp_ep_put_req_hdr_t), \
+            sizeof(uct_tcp_ep_am_rx_into_hdr_t) + sizeof(uct_tcp_am_hdr_t) + \
+            UCT_TCP_EP_AM_RX_INTO_HDR_MAX)
+
+
 /**
  * TCP PUT acknowledge header
  */
@@ -247,6 +294,30 @@ typedef struct uct_tcp_ep_put_ack_hdr {
 } UCS_S_PACKED uct_tcp_ep_put_ack_hdr_t;
 
 
+/**
+ * TCP GET request header
+ */
+typedef struct uct_tcp_ep_get_req_hdr {
+    uint64_t                      addr;        /* Address of a remote memory buffer */
+    size_t                        length;      /* Length of a remote memory buffer */
+} UCS_S_PACKED uct_tcp_ep_get_req_hdr_t;
+
+
+/**
+ * TCP GET operation
+ */
+typedef struct uct_tcp_ep_get_op {
+    uint64_t                      addr;            /* Address of a buffer to receive
+                                                    * data to (GET requester), or to
+                                                    * send data from (GET target) */
+    size_t                        length;          /* Remaining length of the data */
+    uct_completion_t              *comp;           /* User's completion passed to
+                                                    * uct_ep_get_zcopy */
+    ucs_queue_elem_t              elem;            /* Element to insert GET operation
+                                                    * into TCP EP GET queue */
+} uct_tcp_ep_get_op_t;
+
+
 /**
  * TCP PUT completion
  */
@@ -293,7 +364,8 @@ typedef struct uct_tcp_ep_zcopy_tx {
 typedef enum uct_tcp_device_addr_flags {
     /**
      * Device address is extended by additional information:
-     * @ref uct_iface_local_addr_ns_t for loopback reachability
+     * @ref uct_iface_local_addr_ns_t for loopback or UNIX domain socket
+     * reachability
      */
     UCT_TCP_DEVICE_ADDR_FLAG_LOOPBACK = UCS_BIT(0)
 } uct_tcp_device_addr_flags_t;
@@ -307,7 +379,8 @@ typedef struct uct_tcp_device_addr {
     uint8_t sa_family; /* Address family of packed address */
     /* The following packed fields follow:
      * 1. in_addr/in6_addr structure in case of non-loopback interface
-     * 2. @ref uct_iface_local_addr_ns_t in case of loopback interface
+     * 2. @ref uct_iface_local_addr_ns_t in case of loopback interface or
+     *    UNIX domain socket
      */
 } UCS_S_PACKED uct_tcp_device_addr_t;
 
@@ -349,6 +422,10 @@ struct uct_tcp_ep {
     ucs_queue_head_t              pending_q;    /* Pending operations */
     ucs_queue_head_t              put_comp_q;   /* Flush completions waiting for
                                                  * outstanding PUTs acknowledgment */
+    ucs_queue_head_t              get_q;        /* GET operations waiting for
+                                                 * the reply data */
+    ucs_queue_head_t              get_rep_q;    /* GET replies waiting for
+                                                 * TX resources */
     union {
         ucs_list_link_t           list;         /* List element to insert into TCP EP list */
         ucs_conn_match_elem_t     elem;         /* Connection matching element, used by EPs
@@ -377,13 +454,25 @@ typedef struct uct_tcp_iface {
     ucs_sys_event_set_t           *event_set;        /* Event set identifier */
     ucs_mpool_t                   tx_mpool;          /* TX memory pool */
     ucs_mpool_t                   rx_mpool;          /* RX memory pool */
+    ucs_mpool_t                   rx_hdr_mpool;      /* RX memory pool for partially
+                                                      * received headers */
+    void                          *rx_buf;           /* RX buffer shared by EPs which
+                                                      * don't have partially received
+                                                      * data */
     size_t                        outstanding;       /* How much data in the EP send buffers
                                                       * + how many non-blocking connections
                                                       * are in progress + how many EPs are
                                                       * waiting for PUT Zcopy operation ACKs
+                                                      * or GET Zcopy operation replies
                                                       * (0/1 for each EP) */
     ucs_range_spec_t              port_range;        /** Range of ports to use for bind() */
 
+    struct {
+        int                       active;            /* Whether busy polling of the event
+                                                      * set is currently enabled */
+        ucs_time_t                last_event_time;   /* Time of the last received event */
+    } busy_poll;
+
     struct {
         size_t                    tx_seg_size;       /* TX AM buffer size */
         size_t                    rx_seg_size;       /* RX AM buffer size */
@@ -403,6 +492,7 @@ typedef struct uct_tcp_iface {
         ucs_ternary_auto_value_t  ep_bind_src_addr;  /* Bind EP's FD to ifaddr */
         int                       prefer_default;    /* Prefer default gateway */
         int                       put_enable;        /* Enable PUT Zcopy operation support */
+        int                       get_enable;        /* Enable GET Zcopy operation support */
         int                       conn_nb;           /* Use non-blocking connect() */
         unsigned                  max_poll;          /* Number of events to poll per socket*/
         uint8_t                   max_conn_retries;  /* How many connection establishment attempts
@@ -411,7 +501,16 @@ typedef struct uct_tcp_iface {
         unsigned                  syn_cnt;           /* Number of SYN retransmits that TCP should send
                                                       * before aborting the attempt to connect.
                                                       * It cannot exceed 255. */
+        unsigned                  num_paths;         /* Number of connections to a peer
+                                                      * to stripe large messages */
         double                    max_bw;            /* Upper bound to TCP iface bandwidth */
+        struct {
+            unsigned              usec;              /* Busy polling time of the event set,
+                                                      * 0 - disabled */
+            unsigned              budget;            /* Packets to process per busy poll */
+            ucs_time_t            idle;              /* Idle time after which the event set
+                                                      * is switched to interrupt mode */
+        } busy_poll;
         struct {
             ucs_time_t            idle;              /* The time the connection needs to remain
                                                       * idle before TCP starts sending keepalive
@@ -428,6 +527,7 @@ typedef struct uct_tcp_iface {
         int                       nodelay;           /* TCP_NODELAY */
         size_t                    sndbuf;            /* SO_SNDBUF */
         size_t                    rcvbuf;            /* SO_RCVBUF */
+        int                       busy_poll;         /* SO_BUSY_POLL */
     } sockopt;
 } uct_tcp_iface_t;
 
@@ -443,6 +543,7 @@ typedef struct uct_tcp_iface_config {
     size_t                         sendv_thresh;
     int                            prefer_default;
     int                            put_enable;
+    int                            get_enable;
     int                            conn_nb;
     unsigned                       max_poll;
     unsigned                       max_conn_retries;
@@ -459,6 +560,12 @@ typedef struct uct_tcp_iface_config {
         ucs_time_t                 intvl;
     } keepalive;
     ucs_ternary_auto_value_t       ep_bind_src_addr;
+    unsigned                       num_paths;
+    struct {
+        double                     time;
+        unsigned                   budget;
+        ucs_time_t                 idle;
+    } busy_poll;
 } uct_tcp_iface_config_t;
 
 
@@ -471,6 +578,7 @@ typedef struct uct_tcp_md {
         int         af_prio_count;
         sa_family_t af_prio_list[2];
         uint8_t     bridge_enable;
+        uint8_t     unix_enable;
     } config;
 } uct_tcp_md_t;
 
@@ -482,6 +590,7 @@ typedef struct uct_tcp_md_config {
     uct_md_config_t                   super;
     UCS_CONFIG_STRING_ARRAY_FIELD(af) af_prio;
     int                               bridge_enable;
+    int                               unix_enable;
 } uct_tcp_md_config_t;
 
 
@@ -512,6 +621,11 @@ ucs_status_t uct_tcp_netif_caps(const char *if_name, double *latency_p,
 
 ucs_status_t uct_tcp_netif_is_default(const char *if_name, int *result_p);
 
+ucs_status_t uct_tcp_sockaddr_get_port(const struct sockaddr *addr,
+                                       uint16_t *port_p);
+
+ucs_status_t uct_tcp_sockaddr_set_port(struct sockaddr *addr, uint16_t port);
+
 int uct_tcp_sockaddr_cmp(const struct sockaddr *sa1,
                          const struct sockaddr *sa2);
 
@@ -607,6 +721,10 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
                                   size_t iovcnt, uint64_t remote_addr,
                                   uct_rkey_t rkey, uct_completion_t *comp);
 
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp);
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags);
 
@@ -661,6 +779,12 @@ static UCS_F_ALWAYS_INLINE int uct_tcp_ep_ctx_buf_empty(uct_tcp_ep_ctx_t *ctx)
     return ctx->length == 0;
 }
 
+static UCS_F_ALWAYS_INLINE int
+uct_tcp_iface_is_unix(const uct_tcp_iface_t *iface)
+{
+    return iface->config.ifaddr.ss_family == AF_UNIX;
+}
+
 static inline void uct_tcp_iface_outstanding_inc(uct_tcp_iface_t *iface)
 {
     iface->outstanding++;
@@ -674,7 +798,8 @@ static inline void uct_tcp_iface_outstanding_dec(uct_tcp_iface_t *iface)
 
 /**
  * Query for active network devices under /sys/class/net, as determined by
- * ucs_netif_is_active().
+ * ucs_netif_is_active(), and for the UNIX domain socket device if it is
+ * enabled.
  */
 ucs_status_t uct_tcp_query_devices(uct_md_h md,
                                    uct_tl_device_resource_t **devices_p,
@@ -123,6 +123,97 @@ static inline void uct_tcp_ep_ctx_reset(uct_tcp_ep_ctx_t *ctx)
     uct_tcp_ep_ctx_rewind(ctx);
 }
 
+static inline void uct_tcp_ep_rx_ctx_reset(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    /* the shared RX buffer remains owned by the iface, and no buffer is used
+     * while GET reply data is received to a user's buffer */
+    if ((ep->rx.buf != NULL) && (ep->rx.buf != iface->rx_buf)) {
+        ucs_mpool_put_inline(ep->rx.buf);
+    }
+
+    ep->rx.buf = NULL;
+    uct_tcp_ep_ctx_rewind(&ep->rx);
+}
+
+static inline ucs_status_t uct_tcp_ep_rx_buf_get_shared(uct_tcp_iface_t *iface,
+                                                        uct_tcp_ep_t *ep)
+{
+    if (ucs_unlikely(iface->rx_buf == NULL)) {
+        iface->rx_buf = ucs_mpool_get_inline(&iface->rx_mpool);
+        if (ucs_unlikely(iface->rx_buf == NULL)) {
+            ucs_warn("tcp_ep %p: unable to get a buffer from %p memory pool",
+                     ep, &iface->rx_mpool);
+            return UCS_ERR_NO_MEMORY;
+        }
+    }
+
+    if (ep->rx.buf != NULL) {
+        /* continue receiving the partial AM header to the shared buffer */
+        ucs_assertv((ep->rx.offset == 0) &&
+                    (ep->rx.length < sizeof(uct_tcp_am_hdr_t)),
+                    "tcp_ep %p: offset %zu length %zu", ep, ep->rx.offset,
+                    ep->rx.length);
+        memcpy(iface->rx_buf, ep->rx.buf, ep->rx.length);
+        ucs_mpool_put_inline(ep->rx.buf);
+    }
+
+    ep->rx.buf = iface->rx_buf;
+    return UCS_OK;
+}
+
+/* Detach the EP from the shared RX buffer, keeping only the data it still
+ * needs: a partially received AM header, a PUT request or an AM which payload
+ * is received to a user's buffer are copied to a small buffer, while a
+ * partially received AM keeps the whole buffer and the iface allocates a new
+ * shared one on demand */
+static void uct_tcp_ep_rx_buf_put_shared(uct_tcp_iface_t *iface,
+                                         uct_tcp_ep_t *ep)
+{
+    size_t length;
+    void *buf;
+
+    if ((ep->rx.buf == NULL) || (ep->rx.buf != iface->rx_buf)) {
+        return;
+    }
+
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
+        /* PUT request is kept in the beginning of the buffer */
+        ucs_assert(ep->rx.offset == 0);
+        length = sizeof(uct_tcp_ep_put_req_hdr_t);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_AM_RX_INTO) {
+        /* AM receive state and headers are kept in the beginning of the
+         * buffer */
+        ucs_assert(ep->rx.offset == 0);
+        length = ep->rx.length;
+    } else {
+        length = ep->rx.length - ep->rx.offset;
+        if (length == 0) {
+            ep->rx.buf = NULL;
+            uct_tcp_ep_ctx_rewind(&ep->rx);
+            return;
+        } else if (length >= sizeof(uct_tcp_am_hdr_t)) {
+            iface->rx_buf = NULL;
+            return;
+        }
+    }
+
+    buf = ucs_mpool_get_inline(&iface->rx_hdr_mpool);
+    if (ucs_unlikely(buf == NULL)) {
+        iface->rx_buf = NULL;
+        return;
+    }
+
+    memcpy(buf, UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset), length);
+    ep->rx.buf = buf;
+    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
+        ep->rx.offset = 0;
+        ep->rx.length = length;
+    }
+}
+
 int uct_tcp_ep_is_self(const uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -137,7 +228,7 @@ static void uct_tcp_ep_cleanup(uct_tcp_ep_t *ep)
     }
 
     if (ep->rx.buf != NULL) {
-        uct_tcp_ep_ctx_reset(&ep->rx);
+        uct_tcp_ep_rx_ctx_reset(ep);
     }
 
     uct_tcp_ep_mod_events(ep, 0, ep->events);
@@ -241,6 +332,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_ep_t, uct_tcp_iface_t *iface, int fd,
     ucs_list_head_init(&self->list);
     ucs_queue_head_init(&self->pending_q);
     ucs_queue_head_init(&self->put_comp_q);
+    ucs_queue_head_init(&self->get_q);
+    ucs_queue_head_init(&self->get_rep_q);
 
     if (dest_addr != NULL) {
         memcpy(&self->peer_addr[0], dest_addr, iface->config.sockaddr_len);
@@ -353,7 +446,10 @@ uct_tcp_ep_zcopy_completed(uct_tcp_ep_t *ep, uct_completion_t *comp,
 
 static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
 {
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
     uct_tcp_ep_put_completion_t *put_comp;
+    uct_tcp_ep_get_op_t *get_op;
     uct_tcp_ep_zcopy_tx_t *ctx;
 
     ucs_debug("tcp_ep %p: purge outstanding operations with status %s", ep,
@@ -369,6 +465,23 @@ static void uct_tcp_ep_purge(uct_tcp_ep_t *ep, ucs_status_t status)
         uct_invoke_completion(put_comp->comp, status);
         ucs_mpool_put_inline(put_comp);
     }
+
+    if (!ucs_queue_is_empty(&ep->get_q)) {
+        ucs_queue_for_each_extract(get_op, &ep->get_q, elem, 1) {
+            if (get_op->comp != NULL) {
+                uct_invoke_completion(get_op->comp, status);
+            }
+
+            ucs_mpool_put_inline(get_op);
+        }
+
+        ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
+    ucs_queue_for_each_extract(get_op, &ep->get_rep_q, elem, 1) {
+        ucs_mpool_put_inline(get_op);
+    }
 }
 
 static UCS_CLASS_CLEANUP_FUNC(uct_tcp_ep_t)
@@ -636,7 +749,8 @@ static ucs_status_t uct_tcp_ep_bind_src_iface(uct_tcp_ep_t *ep)
     ucs_status_t status;
     int ret;
 
-    if (iface->config.ep_bind_src_addr == UCS_NO) {
+    if ((iface->config.ep_bind_src_addr == UCS_NO) ||
+        uct_tcp_iface_is_unix(iface)) {
         return UCS_OK;
     }
 
@@ -647,7 +761,7 @@ static ucs_status_t uct_tcp_ep_bind_src_iface(uct_tcp_ep_t *ep)
         return status;
     }
 
-    status = ucs_sockaddr_set_port(bind_sockaddr, 0);
+    status = uct_tcp_sockaddr_set_port(bind_sockaddr, 0);
     if (status != UCS_OK) {
         return status;
     }
@@ -733,12 +847,20 @@ void uct_tcp_ep_replace_ep(uct_tcp_ep_t *to_ep, uct_tcp_ep_t *from_ep)
 
     ucs_queue_splice(&to_ep->pending_q, &from_ep->pending_q);
     ucs_queue_splice(&to_ep->put_comp_q, &from_ep->put_comp_q);
+    ucs_queue_splice(&to_ep->get_q, &from_ep->get_q);
+    ucs_queue_splice(&to_ep->get_rep_q, &from_ep->get_rep_q);
 
     to_ep->flags |= from_ep->flags & (UCT_TCP_EP_FLAG_ZCOPY_TX           |
                                       UCT_TCP_EP_FLAG_PUT_RX             |
                                       UCT_TCP_EP_FLAG_PUT_TX_WAITING_ACK |
                                       UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK |
-                                      UCT_TCP_EP_FLAG_NEED_FLUSH);
+                                      UCT_TCP_EP_FLAG_NEED_FLUSH         |
+                                      UCT_TCP_EP_FLAG_GET_RX             |
+                                      UCT_TCP_EP_FLAG_AM_RX_INTO);
+
+    /* The EP is replaced while receiving to the shared buffer, keep the
+     * remaining data in a buffer of the new EP */
+    uct_tcp_ep_rx_buf_put_shared(iface, to_ep);
 
     if (uct_tcp_ep_ctx_buf_need_progress(&to_ep->rx)) {
         /* If some data was already read, we have to process it */
@@ -836,6 +958,13 @@ ucs_status_t uct_tcp_ep_set_dest_addr(const uct_device_addr_t *dev_addr,
     const void *in_addr;
     ucs_status_t status;
 
+    if (tcp_dev_addr->sa_family == AF_UNIX) {
+        memset(dest_addr, 0, sizeof(struct sockaddr_un));
+        dest_addr->sa_family = AF_UNIX;
+        return uct_tcp_sockaddr_set_port(dest_addr,
+                                         ntohs(tcp_iface_addr->port));
+    }
+
     memset(dest_addr, 0, ((tcp_dev_addr->sa_family == AF_INET) ?
                           UCS_IPV4_SOCKADDR_LEN : UCS_IPV6_SOCKADDR_LEN));
     dest_addr->sa_family = tcp_dev_addr->sa_family;
@@ -1264,16 +1393,21 @@ err:
 static inline void uct_tcp_ep_handle_recv_err(uct_tcp_ep_t *ep,
                                               ucs_status_t status)
 {
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
     status = uct_tcp_ep_handle_io_err(ep, "recv", status);
     if ((status == UCS_ERR_NO_PROGRESS) || (status == UCS_ERR_CANCELED)) {
         /* If no data were read to the allocated buffer,
          * we can safely reset it for further re-use and to
          * avoid overwriting this buffer, because `rx::length == 0` */
         if (ep->rx.length == 0) {
-            uct_tcp_ep_ctx_reset(&ep->rx);
+            uct_tcp_ep_rx_ctx_reset(ep);
+        } else {
+            uct_tcp_ep_rx_buf_put_shared(iface, ep);
         }
     } else {
-        uct_tcp_ep_ctx_reset(&ep->rx);
+        uct_tcp_ep_rx_ctx_reset(ep);
         uct_tcp_ep_handle_disconnected(ep, status);
     }
 }
@@ -1314,10 +1448,12 @@ static inline void uct_tcp_ep_check_tx_completion(uct_tcp_ep_t *ep)
     }
 }
 
-/* Forward declaration - the function depends on AM send
+/* Forward declarations - the functions depend on AM send
  * functions implemented below */
 static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep);
 
+static void uct_tcp_ep_post_get_reps(uct_tcp_ep_t *ep);
+
 static unsigned uct_tcp_ep_progress_data_tx(void *arg)
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
@@ -1341,6 +1477,12 @@ static unsigned uct_tcp_ep_progress_data_tx(void *arg)
         uct_tcp_ep_check_tx_completion(ep);
     }
 
+    /* GET replies have to be sent before PUT ACK, since the ACK completes
+     * flush of the GET operations requested prior to it */
+    if (!ucs_queue_is_empty(&ep->get_rep_q)) {
+        uct_tcp_ep_post_get_reps(ep);
+    }
+
     if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK) {
         uct_tcp_ep_post_put_ack(ep);
     }
@@ -1386,7 +1528,7 @@ uct_tcp_ep_put_rx_advance(uct_tcp_ep_t *ep, uct_tcp_ep_put_req_hdr_t *put_req,
          * AM protocol */
         if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
             ep->flags &= ~UCT_TCP_EP_FLAG_PUT_RX;
-            uct_tcp_ep_ctx_reset(&ep->rx);
+            uct_tcp_ep_rx_ctx_reset(ep);
         }
 
         return UCS_OK;
@@ -1429,6 +1571,123 @@ static inline void uct_tcp_ep_handle_put_req(uct_tcp_ep_t *ep,
     ep->flags |= UCT_TCP_EP_FLAG_PUT_RX;
 }
 
+static inline ucs_status_t
+uct_tcp_ep_get_rx_advance(uct_tcp_ep_t *ep, uct_tcp_ep_get_op_t *get_op,
+                          size_t recv_length)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+
+    ucs_assert(recv_length <= get_op->length);
+    get_op->addr   += recv_length;
+    get_op->length -= recv_length;
+
+    if (get_op->length != 0) {
+        return UCS_INPROGRESS;
+    }
+
+    ep->flags &= ~UCT_TCP_EP_FLAG_GET_RX;
+    ucs_queue_pull_non_empty(&ep->get_q);
+    if (ucs_queue_is_empty(&ep->get_q)) {
+        uct_tcp_iface_outstanding_dec(iface);
+    }
+
+    if (get_op->comp != NULL) {
+        uct_invoke_completion(get_op->comp, UCS_OK);
+    }
+
+    ucs_mpool_put_inline(get_op);
+    return UCS_OK;
+}
+
+static inline void uct_tcp_ep_handle_get_req(uct_tcp_ep_t *ep,
+                                             uct_tcp_ep_get_req_hdr_t *get_req)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_get_op_t *get_op;
+
+    ucs_assert(get_req->addr || !get_req->length);
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET reply from mpool", ep);
+        return;
+    }
+
+    get_op->addr   = get_req->addr;
+    get_op->length = get_req->length;
+    get_op->comp   = NULL;
+    ucs_queue_push(&ep->get_rep_q, &get_op->elem);
+
+    uct_tcp_ep_post_get_reps(ep);
+}
+
+static inline void uct_tcp_ep_handle_get_rep(uct_tcp_ep_t *ep,
+                                             size_t extra_recvd_length)
+{
+    uct_tcp_ep_get_op_t *get_op;
+    size_t copied_length;
+
+    get_op        = ucs_queue_head_elem_non_empty(&ep->get_q,
+                                                  uct_tcp_ep_get_op_t, elem);
+    copied_length = ucs_min(get_op->length, extra_recvd_length);
+    memcpy((void*)(uintptr_t)get_op->addr,
+           UCS_PTR_BYTE_OFFSET(ep->rx.buf, ep->rx.offset), copied_length);
+    ep->rx.offset += copied_length;
+
+    if (uct_tcp_ep_get_rx_advance(ep, get_op, copied_length) == UCS_OK) {
+        return;
+    }
+
+    /* The rest of the reply is received directly to the user's buffer */
+    ucs_assert(ep->rx.offset == ep->rx.length);
+    ep->flags |= UCT_TCP_EP_FLAG_GET_RX;
+}
+
+/* Start receiving the payload of a partially received AM to a buffer provided
+ * by the user, if the AM handler supports it. The AM receive state and the
+ * headers are moved to the beginning of the RX buffer. */
+static void uct_tcp_ep_am_rx_into_start(uct_tcp_iface_t *iface,
+                                        uct_tcp_ep_t *ep, uct_tcp_am_hdr_t *hdr,
+                                        size_t recvd_length)
+{
+    uct_am_handler_t *handler = &iface->super.am[hdr->am_id];
+    size_t hdr_length         = handler->recv_into_hdr_length;
+    uct_tcp_ep_am_rx_into_hdr_t rx_into;
+    size_t copied_length;
+    void *buffer;
+
+    if ((handler->recv_into_cb == NULL) ||
+        (hdr_length > UCT_TCP_EP_AM_RX_INTO_HDR_MAX) ||
+        (recvd_length < (sizeof(*hdr) + hdr_length))) {
+        return;
+    }
+
+    buffer = handler->recv_into_cb(handler->recv_into_arg, hdr + 1,
+                                   hdr->length);
+    if (buffer == NULL) {
+        return;
+    }
+
+    copied_length = recvd_length - sizeof(*hdr) - hdr_length;
+    memcpy(buffer, UCS_PTR_BYTE_OFFSET(hdr + 1, hdr_length), copied_length);
+
+    rx_into.addr   = (uintptr_t)UCS_PTR_BYTE_OFFSET(buffer, copied_length);
+    rx_into.length = hdr->length - hdr_length - copied_length;
+    ucs_assert(rx_into.length != 0);
+
+    ucs_trace_data("tcp_ep %p: receiving %u bytes of am_id %u to %p", ep,
+                   hdr->length, hdr->am_id, buffer);
+
+    memmove(UCS_PTR_BYTE_OFFSET(ep->rx.buf, sizeof(rx_into)), hdr,
+            sizeof(*hdr) + hdr_length);
+    memcpy(ep->rx.buf, &rx_into, sizeof(rx_into));
+    ep->rx.offset = 0;
+    ep->rx.length = sizeof(rx_into) + sizeof(*hdr) + hdr_length;
+    ep->flags    |= UCT_TCP_EP_FLAG_AM_RX_INTO;
+}
+
 static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
@@ -1441,18 +1700,13 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
 
     ucs_trace_func("ep=%p", ep);
 
-    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx)) {
-        if (ucs_unlikely(uct_tcp_ep_ctx_buf_alloc(
-                                ep, &ep->rx, &iface->rx_mpool) != UCS_OK)) {
+    if (!uct_tcp_ep_ctx_buf_need_progress(&ep->rx) ||
+        (ep->rx.length < sizeof(*hdr))) {
+        if (ucs_unlikely(uct_tcp_ep_rx_buf_get_shared(iface, ep) != UCS_OK)) {
             return 0;
         }
 
-        /* post the entire AM buffer */
-        recv_length = iface->config.rx_seg_size;
-    } else if (ep->rx.length < sizeof(*hdr)) {
-        ucs_assert((ep->rx.buf != NULL) && (ep->rx.offset == 0));
-
-        /* do partial receive of the remaining part of the hdr
+        /* do partial receive of the remaining part of the hdr, if any,
          * and post the entire AM buffer */
         recv_length = iface->config.rx_seg_size - ep->rx.length;
     } else {
@@ -1466,7 +1720,9 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
     }
 
     if (!uct_tcp_ep_recv(ep, recv_length)) {
-        goto out;
+        /* Do not touch EP here as it could be destroyed during
+         * socket error handling */
+        return 0;
     }
 
     /* Parse received active messages */
@@ -1489,6 +1745,10 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
                     (iface->config.rx_seg_size - sizeof(*hdr)));
 
         if (remaining < (sizeof(*hdr) + hdr->length)) {
+            if (hdr->am_id < UCT_AM_ID_MAX) {
+                uct_tcp_ep_am_rx_into_start(iface, ep, hdr, remaining);
+            }
+
             handled++;
             goto out;
         }
@@ -1524,6 +1784,14 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
             ucs_assert(hdr->length == sizeof(uint32_t));
             uct_tcp_ep_handle_put_ack(ep, (uct_tcp_ep_put_ack_hdr_t*)(hdr + 1));
             handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REQ_AM_ID) {
+            ucs_assert(hdr->length == sizeof(uct_tcp_ep_get_req_hdr_t));
+            uct_tcp_ep_handle_get_req(ep, (uct_tcp_ep_get_req_hdr_t*)(hdr + 1));
+            handled++;
+        } else if (hdr->am_id == UCT_TCP_EP_GET_REP_AM_ID) {
+            ucs_assert(hdr->length == 0);
+            uct_tcp_ep_handle_get_rep(ep, ep->rx.length - ep->rx.offset);
+            handled++;
         } else if (hdr->am_id == UCT_TCP_EP_KEEPALIVE_AM_ID) {
             /* just ignore keepalive requests */
             handled++;
@@ -1539,9 +1807,13 @@ static unsigned uct_tcp_ep_progress_am_rx(uct_tcp_ep_t *ep)
         ucs_assert(ep != NULL);
     }
 
-    uct_tcp_ep_ctx_reset(&ep->rx);
+    uct_tcp_ep_rx_ctx_reset(ep);
 
 out:
+    if (ep != NULL) {
+        uct_tcp_ep_rx_buf_put_shared(iface, ep);
+    }
+
     return handled;
 }
 
@@ -1598,14 +1870,87 @@ static unsigned uct_tcp_ep_progress_put_rx(uct_tcp_ep_t *ep)
     return 1;
 }
 
+static unsigned uct_tcp_ep_progress_get_rx(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_get_op_t *get_op;
+    size_t recv_length;
+    ucs_status_t status;
+
+    get_op      = ucs_queue_head_elem_non_empty(&ep->get_q,
+                                                uct_tcp_ep_get_op_t, elem);
+    recv_length = get_op->length;
+    status      = ucs_socket_recv_nb(ep->fd, (void*)(uintptr_t)get_op->addr,
+                                     &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        uct_tcp_ep_handle_recv_err(ep, status);
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+
+    uct_tcp_ep_get_rx_advance(ep, get_op, recv_length);
+
+    return 1;
+}
+
+static unsigned uct_tcp_ep_progress_am_rx_into(uct_tcp_ep_t *ep)
+{
+    uct_tcp_iface_t *iface = ucs_derived_of(ep->super.super.iface,
+                                            uct_tcp_iface_t);
+    uct_tcp_ep_am_rx_into_hdr_t *rx_into;
+    uct_tcp_am_hdr_t *hdr;
+    size_t recv_length;
+    size_t hdr_length;
+    ucs_status_t status;
+
+    rx_into     = (uct_tcp_ep_am_rx_into_hdr_t*)ep->rx.buf;
+    recv_length = rx_into->length;
+    status      = ucs_socket_recv_nb(ep->fd, (void*)(uintptr_t)rx_into->addr,
+                                     &recv_length);
+    if (ucs_unlikely(status != UCS_OK)) {
+        uct_tcp_ep_handle_recv_err(ep, status);
+        return 0;
+    }
+
+    ucs_assertv(recv_length, "ep=%p", ep);
+
+    rx_into->addr   += recv_length;
+    rx_into->length -= recv_length;
+    if (rx_into->length != 0) {
+        return 1;
+    }
+
+    hdr        = (uct_tcp_am_hdr_t*)(rx_into + 1);
+    hdr_length = ep->rx.length - sizeof(*rx_into) - sizeof(*hdr);
+    ep->flags &= ~UCT_TCP_EP_FLAG_AM_RX_INTO;
+
+    uct_iface_trace_am(&iface->super, UCT_AM_TRACE_TYPE_RECV, hdr->am_id,
+                       hdr + 1, hdr_length,
+                       "RECV: ep %p fd %d received %u bytes to user buffer",
+                       ep, ep->fd, hdr->length);
+    uct_iface_invoke_am(&iface->super, hdr->am_id, hdr + 1, hdr->length,
+                        UCT_CB_PARAM_FLAG_RECV_INTO);
+
+    /* the RX context could be moved to a new EP from the AM handler */
+    if (ep->rx.buf != NULL) {
+        uct_tcp_ep_rx_ctx_reset(ep);
+    }
+
+    return 1;
+}
+
 static unsigned uct_tcp_ep_progress_data_rx(void *arg)
 {
     uct_tcp_ep_t *ep = (uct_tcp_ep_t*)arg;
 
-    if (!(ep->flags & UCT_TCP_EP_FLAG_PUT_RX)) {
-        return uct_tcp_ep_progress_am_rx(ep);
-    } else {
+    if (ep->flags & UCT_TCP_EP_FLAG_PUT_RX) {
         return uct_tcp_ep_progress_put_rx(ep);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_GET_RX) {
+        return uct_tcp_ep_progress_get_rx(ep);
+    } else if (ep->flags & UCT_TCP_EP_FLAG_AM_RX_INTO) {
+        return uct_tcp_ep_progress_am_rx_into(ep);
+    } else {
+        return uct_tcp_ep_progress_am_rx(ep);
     }
 }
 
@@ -1621,7 +1966,7 @@ static unsigned uct_tcp_ep_progress_magic_number_rx(void *arg)
 
     if (ep->rx.buf == NULL) {
         if (ucs_unlikely(uct_tcp_ep_ctx_buf_alloc(
-                                ep, &ep->rx, &iface->rx_mpool) != UCS_OK)) {
+                                ep, &ep->rx, &iface->rx_hdr_mpool) != UCS_OK)) {
             return 0;
         }
     }
@@ -1653,7 +1998,7 @@ static unsigned uct_tcp_ep_progress_magic_number_rx(void *arg)
         goto err;
     }
 
-    uct_tcp_ep_ctx_reset(&ep->rx);
+    uct_tcp_ep_rx_ctx_reset(ep);
 
     uct_tcp_cm_change_conn_state(ep, UCT_TCP_EP_CONN_STATE_ACCEPTING);
 
@@ -1782,6 +2127,13 @@ static void uct_tcp_ep_post_put_ack(uct_tcp_ep_t *ep)
     uct_tcp_ep_put_ack_hdr_t *put_ack;
     ucs_status_t status;
 
+    if (!ucs_queue_is_empty(&ep->get_rep_q)) {
+        /* PUT ACK will be sent after the GET replies which wait for TX
+         * resources, to not complete a flush of the peer before them */
+        ep->flags |= UCT_TCP_EP_FLAG_PUT_RX_SENDING_ACK;
+        return;
+    }
+
     /* Make sure that we are sending nothing through this EP at the moment.
      * This check is needed to avoid mixing AM/PUT data sent from this EP
      * and this PUT ACK message */
@@ -2144,6 +2496,128 @@ ucs_status_t uct_tcp_ep_put_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
     return UCS_INPROGRESS;
 }
 
+static ucs_status_t
+uct_tcp_ep_send_get_rep(uct_tcp_ep_t *ep, const uct_tcp_ep_get_op_t *get_op)
+{
+    uct_tcp_iface_t *iface     = ucs_derived_of(ep->super.super.iface,
+                                                uct_tcp_iface_t);
+    uct_tcp_ep_zcopy_tx_t *ctx = NULL;
+    uct_iov_t iov;
+    ucs_status_t status;
+
+    iov.buffer = (void*)(uintptr_t)get_op->addr;
+    iov.length = get_op->length;
+    iov.memh   = UCT_MEM_HANDLE_NULL;
+    iov.stride = 0;
+    iov.count  = 1;
+
+    status = uct_tcp_ep_prepare_zcopy(iface, ep, UCT_TCP_EP_GET_REP_AM_ID,
+                                      NULL, 0, &iov, 1, "get_rep",
+                                      /* GET reply data follows the TCP AM
+                                       * hdr, but isn't counted in its
+                                       * length, as for PUT Zcopy */
+                                      &ep->tx.length, &ctx);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    ctx->super.length = 0;
+
+    status = uct_tcp_ep_am_sendv(ep, 0, &ctx->super, UCT_TCP_EP_GET_ZCOPY_MAX,
+                                 NULL, ctx->iov, ctx->iov_cnt);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    if (uct_tcp_ep_ctx_buf_need_progress(&ep->tx)) {
+        uct_tcp_ep_set_outstanding_zcopy(iface, ep, ctx, NULL, 0, NULL);
+    }
+
+    return UCS_OK;
+}
+
+static void uct_tcp_ep_post_get_reps(uct_tcp_ep_t *ep)
+{
+    uct_tcp_ep_get_op_t *get_op;
+    ucs_status_t status;
+
+    /* Send the data requested by the peer in the order of GET requests,
+     * the peer matches the replies to its outstanding GET operations */
+    while (!ucs_queue_is_empty(&ep->get_rep_q)) {
+        get_op = ucs_queue_head_elem_non_empty(&ep->get_rep_q,
+                                               uct_tcp_ep_get_op_t, elem);
+        status = uct_tcp_ep_send_get_rep(ep, get_op);
+        if (status != UCS_OK) {
+            if (status != UCS_ERR_NO_RESOURCE) {
+                ucs_error("tcp_ep %p: failed to send GET reply: %s", ep,
+                          ucs_status_string(status));
+            }
+            return;
+        }
+
+        ucs_queue_pull_non_empty(&ep->get_rep_q);
+        ucs_mpool_put_inline(get_op);
+    }
+}
+
+ucs_status_t uct_tcp_ep_get_zcopy(uct_ep_h uct_ep, const uct_iov_t *iov,
+                                  size_t iovcnt, uint64_t remote_addr,
+                                  uct_rkey_t rkey, uct_completion_t *comp)
+{
+    uct_tcp_ep_t *ep       = ucs_derived_of(uct_ep, uct_tcp_ep_t);
+    uct_tcp_iface_t *iface = ucs_derived_of(uct_ep->iface, uct_tcp_iface_t);
+    uct_tcp_am_hdr_t *hdr  = NULL;
+    uct_tcp_ep_get_req_hdr_t *get_req;
+    uct_tcp_ep_get_op_t *get_op;
+    ucs_status_t status;
+
+    UCT_CHECK_IOV_SIZE(iovcnt, 1ul, "get_zcopy");
+    UCT_CHECK_LENGTH(uct_iov_total_length(iov, iovcnt), 0,
+                     UCT_TCP_EP_GET_ZCOPY_MAX, "get_zcopy");
+
+    status = uct_tcp_ep_am_prepare(iface, ep, UCT_TCP_EP_GET_REQ_AM_ID, &hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        return status;
+    }
+
+    get_op = ucs_mpool_get_inline(&iface->tx_mpool);
+    if (ucs_unlikely(get_op == NULL)) {
+        ucs_error("tcp_ep %p: unable to allocate GET operation from mpool",
+                  ep);
+        uct_tcp_ep_ctx_reset(&ep->tx);
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    get_op->addr   = (iovcnt == 0) ? 0 : (uintptr_t)iov[0].buffer;
+    get_op->length = uct_iov_total_length(iov, iovcnt);
+    get_op->comp   = comp;
+
+    ucs_assertv(hdr != NULL, "ep=%p", ep);
+    hdr->length     = sizeof(*get_req);
+    get_req         = (uct_tcp_ep_get_req_hdr_t*)(hdr + 1);
+    get_req->addr   = remote_addr;
+    get_req->length = get_op->length;
+
+    status = uct_tcp_ep_am_send(ep, hdr);
+    if (ucs_unlikely(status != UCS_OK)) {
+        ucs_mpool_put_inline(get_op);
+        return status;
+    }
+
+    if (ucs_queue_is_empty(&ep->get_q)) {
+        /* Increment iface outstanding operations counter in order to ensure
+         * returning UCS_INPROGRESS from iface flush while GET replies are
+         * being received. It is decremented when the last outstanding GET
+         * operation on the EP is completed */
+        uct_tcp_iface_outstanding_inc(iface);
+    }
+
+    ucs_queue_push(&ep->get_q, &get_op->elem);
+    UCT_TL_EP_STAT_OP(&ep->super, GET, ZCOPY, get_op->length);
+
+    return UCS_INPROGRESS;
+}
+
 ucs_status_t uct_tcp_ep_pending_add(uct_ep_h tl_ep, uct_pending_req_t *req,
                                     unsigned flags)
 {
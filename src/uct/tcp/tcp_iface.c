@@ -21,6 +21,13 @@
 
 #define UCT_TCP_IFACE_NETDEV_DIR "/sys/class/net"
 
+/* Latency of UNIX domain sockets, which do not pass through the network
+ * stack */
+#define UCT_TCP_IFACE_UNIX_LATENCY 2e-6
+
+/* Default send buffer size of UNIX domain sockets */
+#define UCT_TCP_IFACE_UNIX_SNDBUF  (4 * UCS_MBYTE)
+
 extern ucs_class_t UCS_CLASS_DECL_NAME(uct_tcp_iface_t);
 
 static ucs_config_field_t uct_tcp_iface_config_table[] = {
@@ -53,6 +60,10 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
    "Enable PUT Zcopy support",
    ucs_offsetof(uct_tcp_iface_config_t, put_enable), UCS_CONFIG_TYPE_BOOL},
 
+  {"GET_ENABLE", "y",
+   "Enable GET Zcopy support",
+   ucs_offsetof(uct_tcp_iface_config_t, get_enable), UCS_CONFIG_TYPE_BOOL},
+
   {"CONN_NB", "n",
    "Enable non-blocking connection establishment. It may improve startup "
    "time, but can lead to connection resets due to high load on TCP/IP stack",
@@ -111,6 +122,35 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
                 UCS_CONFIG_TYPE_TIME_UNITS},
 #endif /* UCT_TCP_EP_KEEPALIVE */
 
+  {"NUM_PATHS", "1",
+   "Number of connections that should be created between a pair of\n"
+   "communicating endpoints. Large messages are striped across these\n"
+   "connections, which are processed by different NIC queues and CPU cores.\n"
+   "The number of connections used for rendezvous protocol is also limited\n"
+   "by "UCS_DEFAULT_ENV_PREFIX"MAX_RNDV_RAILS configuration.",
+   ucs_offsetof(uct_tcp_iface_config_t, num_paths), UCS_CONFIG_TYPE_UINT},
+
+  {"BUSY_POLL", "0",
+   "Busy polling time of the sockets and the event set of the interface.\n"
+   "Busy polling reduces latency by polling the device queues while waiting\n"
+   "for data instead of relying on device interrupts, at the cost of CPU\n"
+   "usage. Values above the net.core.busy_read and net.core.busy_poll system\n"
+   "settings require CAP_NET_ADMIN. 0 disables busy polling.",
+   ucs_offsetof(uct_tcp_iface_config_t, busy_poll.time), UCS_CONFIG_TYPE_TIME},
+
+  {"BUSY_POLL_BUDGET", "8",
+   "Maximal number of packets to process during one busy polling attempt.\n"
+   "Values above 64 require CAP_NET_ADMIN.",
+   ucs_offsetof(uct_tcp_iface_config_t, busy_poll.budget),
+   UCS_CONFIG_TYPE_UINT},
+
+  {"BUSY_POLL_IDLE", "1ms",
+   "Switch the event set of the interface from busy polling to interrupt mode\n"
+   "when no events were received during this time, and back to busy polling\n"
+   "on the next received event. \"inf\" keeps busy polling always enabled.",
+   ucs_offsetof(uct_tcp_iface_config_t, busy_poll.idle),
+   UCS_CONFIG_TYPE_TIME_UNITS},
+
   {"EP_BIND_SRC_ADDR", "try",
    "Bind client socket to the local network interface before connecting to the "
    "remote peer",
@@ -123,6 +163,15 @@ static ucs_config_field_t uct_tcp_iface_config_table[] = {
 
 static UCS_CLASS_DEFINE_DELETE_FUNC(uct_tcp_iface_t, uct_iface_t);
 
+/* Loopback and UNIX domain socket addresses are reachable only from the same
+ * network namespace */
+static int uct_tcp_iface_is_local(const uct_tcp_iface_t *iface)
+{
+    return uct_tcp_iface_is_unix(iface) ||
+           ucs_sockaddr_is_inaddr_loopback(
+                   (const struct sockaddr*)&iface->config.ifaddr);
+}
+
 static ucs_status_t uct_tcp_iface_get_device_address(uct_iface_h tl_iface,
                                                      uct_device_addr_t *addr)
 {
@@ -137,7 +186,7 @@ static ucs_status_t uct_tcp_iface_get_device_address(uct_iface_h tl_iface,
     dev_addr->flags     = 0;
     dev_addr->sa_family = saddr->sa_family;
 
-    if (ucs_sockaddr_is_inaddr_loopback(saddr)) {
+    if (uct_tcp_iface_is_local(iface)) {
         dev_addr->flags |= UCT_TCP_DEVICE_ADDR_FLAG_LOOPBACK;
         memset(pack_ptr, 0, sizeof(uct_iface_local_addr_ns_t));
         uct_iface_get_local_address(pack_ptr, UCS_SYS_NS_TYPE_NET);
@@ -161,7 +210,7 @@ static size_t uct_tcp_iface_get_device_address_length(uct_tcp_iface_t *iface)
     size_t in_addr_len;
     ucs_status_t status;
 
-    if (ucs_sockaddr_is_inaddr_loopback(saddr)) {
+    if (uct_tcp_iface_is_local(iface)) {
         addr_len += sizeof(uct_iface_local_addr_ns_t);
     } else {
         status = ucs_sockaddr_inet_addr_sizeof(saddr, &in_addr_len);
@@ -182,8 +231,8 @@ uct_tcp_iface_get_address(uct_iface_h tl_iface, uct_iface_addr_t *addr)
     ucs_status_t status;
     uint16_t port;
 
-    status = ucs_sockaddr_get_port((struct sockaddr*)&iface->config.ifaddr,
-                                   &port);
+    status = uct_tcp_sockaddr_get_port((struct sockaddr*)&iface->config.ifaddr,
+                                       &port);
     if (status != UCS_OK) {
         return status;
     }
@@ -213,8 +262,7 @@ uct_tcp_iface_is_reachable_v2(const uct_iface_h tl_iface,
 
     /* Loopback can connect only to loopback */
     if (!!(tcp_dev_addr->flags & UCT_TCP_DEVICE_ADDR_FLAG_LOOPBACK) !=
-        ucs_sockaddr_is_inaddr_loopback(
-                (const struct sockaddr*)&iface->config.ifaddr)) {
+        uct_tcp_iface_is_local(iface)) {
         return 0;
     }
 
@@ -266,14 +314,21 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
 
     uct_base_iface_query(&iface->super, attr);
 
-    status = uct_tcp_netif_caps(iface->if_name, &attr->latency.c, &network_bw);
-    if (status != UCS_OK) {
-        return status;
-    }
+    if (uct_tcp_iface_is_unix(iface)) {
+        attr->latency.c    = UCT_TCP_IFACE_UNIX_LATENCY;
+        calculated_bw      = DBL_MAX;
+    } else {
+        status = uct_tcp_netif_caps(iface->if_name, &attr->latency.c,
+                                    &network_bw);
+        if (status != UCS_OK) {
+            return status;
+        }
 
-    sysfs_path             = uct_tcp_iface_get_sysfs_path(iface->if_name, path_buffer);
-    pci_bw                 = ucs_topo_get_pci_bw(iface->if_name, sysfs_path);
-    calculated_bw          = ucs_min(pci_bw, network_bw);
+        sysfs_path         = uct_tcp_iface_get_sysfs_path(iface->if_name,
+                                                          path_buffer);
+        pci_bw             = ucs_topo_get_pci_bw(iface->if_name, sysfs_path);
+        calculated_bw      = ucs_min(pci_bw, network_bw);
+    }
 
     /* Bandwidth is bounded by TCP stack computation time */
     attr->bandwidth.shared = ucs_min(calculated_bw, iface->config.max_bw);
@@ -319,11 +374,20 @@ static ucs_status_t uct_tcp_iface_query(uct_iface_h tl_iface,
             attr->cap.put.opt_zcopy_align  = 1;
             attr->cap.flags               |= UCT_IFACE_FLAG_PUT_ZCOPY;
         }
+
+        if (iface->config.get_enable) {
+            /* GET */
+            attr->cap.get.max_iov          = 1;
+            attr->cap.get.max_zcopy        = UCT_TCP_EP_GET_ZCOPY_MAX;
+            attr->cap.get.opt_zcopy_align  = 1;
+            attr->cap.flags               |= UCT_IFACE_FLAG_GET_ZCOPY;
+        }
     }
 
     attr->bandwidth.dedicated = 0;
     attr->latency.m           = 0;
     attr->overhead            = 50e-6;  /* 50 usec */
+    attr->dev_num_paths       = iface->config.num_paths;
 
     if (iface->config.prefer_default) {
         status = uct_tcp_netif_is_default(iface->if_name, &is_default);
@@ -363,6 +427,37 @@ static void uct_tcp_iface_handle_events(void *callback_data,
     }
 }
 
+static void uct_tcp_iface_busy_poll_set(uct_tcp_iface_t *iface, int active)
+{
+    ucs_status_t status;
+
+    status = ucs_event_set_busy_poll(iface->event_set,
+                                     active ? iface->config.busy_poll.usec : 0,
+                                     iface->config.busy_poll.budget, active);
+    if (status == UCS_OK) {
+        iface->busy_poll.active = active;
+    }
+}
+
+/* Busy polling of the event set is switched off when the interface is idle,
+ * to let the device interrupts notify about new events, and switched back on
+ * when events are received */
+static UCS_F_ALWAYS_INLINE void
+uct_tcp_iface_busy_poll_update(uct_tcp_iface_t *iface, unsigned count)
+{
+    if (count != 0) {
+        iface->busy_poll.last_event_time = ucs_get_time();
+        if (!iface->busy_poll.active) {
+            uct_tcp_iface_busy_poll_set(iface, 1);
+        }
+    } else if (iface->busy_poll.active &&
+               (iface->config.busy_poll.idle != UCS_TIME_INFINITY) &&
+               ((ucs_get_time() - iface->busy_poll.last_event_time) >
+                iface->config.busy_poll.idle)) {
+        uct_tcp_iface_busy_poll_set(iface, 0);
+    }
+}
+
 unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
 {
     uct_tcp_iface_t *iface = ucs_derived_of(tl_iface, uct_tcp_iface_t);
@@ -384,6 +479,10 @@ unsigned uct_tcp_iface_progress(uct_iface_h tl_iface)
     } while ((max_events > 0) && (read_events == UCT_TCP_MAX_EVENTS) &&
              ((status == UCS_OK) || (status == UCS_INPROGRESS)));
 
+    if (iface->config.busy_poll.usec != 0) {
+        uct_tcp_iface_busy_poll_update(iface, count);
+    }
+
     return count;
 }
 
@@ -451,6 +550,17 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
         }
     }
 
+    status = ucs_socket_set_buffer_size(fd, iface->sockopt.sndbuf,
+                                        iface->sockopt.rcvbuf);
+    if (status != UCS_OK) {
+        return status;
+    }
+
+    if (uct_tcp_iface_is_unix(iface)) {
+        /* TCP level options are not applicable to UNIX domain sockets */
+        return UCS_OK;
+    }
+
     status = ucs_socket_setopt(fd, IPPROTO_TCP, TCP_NODELAY,
                                (const void*)&iface->sockopt.nodelay,
                                sizeof(int));
@@ -458,11 +568,16 @@ ucs_status_t uct_tcp_iface_set_sockopt(uct_tcp_iface_t *iface, int fd,
         return status;
     }
 
-    status = ucs_socket_set_buffer_size(fd, iface->sockopt.sndbuf,
-                                        iface->sockopt.rcvbuf);
-    if (status != UCS_OK) {
-        return status;
+#ifdef SO_BUSY_POLL
+    if (iface->sockopt.busy_poll != 0) {
+        status = ucs_socket_setopt(fd, SOL_SOCKET, SO_BUSY_POLL,
+                                   (const void*)&iface->sockopt.busy_poll,
+                                   sizeof(int));
+        if (status != UCS_OK) {
+            return status;
+        }
     }
+#endif
 
     return ucs_tcp_base_set_syn_cnt(fd, iface->config.syn_cnt);
 }
@@ -473,6 +588,7 @@ static uct_iface_ops_t uct_tcp_iface_ops = {
     .ep_am_bcopy              = uct_tcp_ep_am_bcopy,
     .ep_am_zcopy              = uct_tcp_ep_am_zcopy,
     .ep_put_zcopy             = uct_tcp_ep_put_zcopy,
+    .ep_get_zcopy             = uct_tcp_ep_get_zcopy,
     .ep_pending_add           = uct_tcp_ep_pending_add,
     .ep_pending_purge         = uct_tcp_ep_pending_purge,
     .ep_flush                 = uct_tcp_ep_flush,
@@ -515,11 +631,18 @@ static ucs_status_t uct_tcp_iface_server_init(uct_tcp_iface_t *iface)
             if (status != UCS_OK) {
                 break;
             }
+        } else if (uct_tcp_iface_is_unix(iface)) {
+            /* the operating system can't choose the port of a UNIX domain
+             * socket, so select a random one and retry if it is in use */
+            status = ucs_rand_range(1, UINT16_MAX, &port);
+            if (status != UCS_OK) {
+                break;
+            }
         } else {
             port = 0;   /* let the operating system choose the port */
         }
 
-        status = ucs_sockaddr_set_port((struct sockaddr*)&bind_addr, port);
+        status = uct_tcp_sockaddr_set_port((struct sockaddr*)&bind_addr, port);
         if (status != UCS_OK) {
             break;
         }
@@ -559,13 +682,13 @@ static ucs_status_t uct_tcp_iface_listener_init(uct_tcp_iface_t *iface)
         goto err_close_sock;
     }
 
-    status = ucs_sockaddr_get_port((struct sockaddr*)&bind_addr, &port);
+    status = uct_tcp_sockaddr_get_port((struct sockaddr*)&bind_addr, &port);
     if (status != UCS_OK) {
         goto err_close_sock;
     }
 
-    status = ucs_sockaddr_set_port((struct sockaddr*)&iface->config.ifaddr,
-                                   port);
+    status = uct_tcp_sockaddr_set_port((struct sockaddr*)&iface->config.ifaddr,
+                                       port);
     if (status != UCS_OK) {
         goto err_close_sock;
     }
@@ -676,6 +799,28 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         return UCS_ERR_INVALID_PARAM;
     }
 
+    if ((config->num_paths == 0) || (config->num_paths > UINT8_MAX)) {
+        ucs_error("unsupported value was specified (%u) for the number of "
+                  "paths, expected between 1 and %u", config->num_paths,
+                  UINT8_MAX);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    if ((config->busy_poll.time < 0) ||
+        ((config->busy_poll.time * UCS_USEC_PER_SEC) > INT_MAX)) {
+        ucs_error("unsupported value was specified (%.2f usec) for the busy "
+                  "polling time, expected between 0 and %d usec",
+                  config->busy_poll.time * UCS_USEC_PER_SEC, INT_MAX);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+#ifndef SO_BUSY_POLL
+    if (config->busy_poll.time != 0) {
+        ucs_error("busy polling of sockets is not supported");
+        return UCS_ERR_UNSUPPORTED;
+    }
+#endif
+
     if (config->max_conn_retries > UINT8_MAX) {
         ucs_error("unsupported value was specified (%u) for the maximal "
                   "connection retries, expected lower than %u",
@@ -687,13 +832,19 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
                                      self->config.zcopy.hdr_offset;
     self->config.prefer_default    = config->prefer_default;
     self->config.put_enable        = config->put_enable;
+    self->config.get_enable        = config->get_enable;
     self->config.conn_nb           = config->conn_nb;
     self->config.max_poll          = config->max_poll;
     self->config.max_conn_retries  = config->max_conn_retries;
+    self->config.num_paths         = config->num_paths;
     self->config.syn_cnt           = config->syn_cnt;
     self->sockopt.nodelay          = config->sockopt_nodelay;
     self->sockopt.sndbuf           = config->sockopt.sndbuf;
     self->sockopt.rcvbuf           = config->sockopt.rcvbuf;
+    self->sockopt.busy_poll        = config->busy_poll.time * UCS_USEC_PER_SEC;
+    self->config.busy_poll.usec    = self->sockopt.busy_poll;
+    self->config.busy_poll.budget  = config->busy_poll.budget;
+    self->config.busy_poll.idle    = config->busy_poll.idle;
     self->config.keepalive.cnt     = config->keepalive.cnt;
     self->config.keepalive.intvl   = config->keepalive.intvl;
     self->config.ep_bind_src_addr  = config->ep_bind_src_addr;
@@ -747,18 +898,45 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
         goto err_cleanup_tx_mpool;
     }
 
-    for (i = 0; i < tcp_md->config.af_prio_count; i++) {
-        status = ucs_netif_get_addr(self->if_name,
-                                    tcp_md->config.af_prio_list[i],
-                                    (struct sockaddr*)&self->config.ifaddr,
-                                    (struct sockaddr*)&self->config.netmask);
-        if (status == UCS_OK) {
-            break;
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elems_per_chunk = 256;
+    mp_params.elem_size       = UCT_TCP_EP_RX_HDR_BUF_SIZE;
+    mp_params.ops             = &uct_tcp_mpool_ops;
+    mp_params.name            = "uct_tcp_iface_rx_hdr_buf_mp";
+    status = ucs_mpool_init(&mp_params, &self->rx_hdr_mpool);
+    if (status != UCS_OK) {
+        goto err_cleanup_rx_mpool;
+    }
+
+    self->rx_buf = NULL;
+
+    if (!strcmp(self->if_name, UCT_TCP_UNIX_DEV_NAME)) {
+        /* The name of the socket is set when the listener is created */
+        memset(&self->config.ifaddr, 0, sizeof(self->config.ifaddr));
+        memset(&self->config.netmask, 0, sizeof(self->config.netmask));
+        self->config.ifaddr.ss_family = AF_UNIX;
+        status                        = UCS_OK;
+
+        if (self->sockopt.sndbuf == UCS_MEMUNITS_AUTO) {
+            /* Sent data is accounted to the send buffer of a UNIX domain
+             * socket until the peer receives it, so the small system default
+             * limits the bandwidth */
+            self->sockopt.sndbuf = UCT_TCP_IFACE_UNIX_SNDBUF;
+        }
+    } else {
+        for (i = 0; i < tcp_md->config.af_prio_count; i++) {
+            status = ucs_netif_get_addr(self->if_name,
+                                        tcp_md->config.af_prio_list[i],
+                                        (struct sockaddr*)&self->config.ifaddr,
+                                        (struct sockaddr*)&self->config.netmask);
+            if (status == UCS_OK) {
+                break;
+            }
         }
     }
 
     if (status != UCS_OK) {
-        goto err_cleanup_rx_mpool;
+        goto err_cleanup_rx_hdr_mpool;
     }
 
     status = ucs_sockaddr_sizeof((struct sockaddr*)&self->config.ifaddr,
@@ -776,7 +954,24 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
     status = ucs_event_set_create(&self->event_set);
     if (status != UCS_OK) {
         status = UCS_ERR_IO_ERROR;
-        goto err_cleanup_rx_mpool;
+        goto err_cleanup_rx_hdr_mpool;
+    }
+
+    self->busy_poll.active          = 0;
+    self->busy_poll.last_event_time = ucs_get_time();
+    if (self->config.busy_poll.usec != 0) {
+        status = ucs_event_set_busy_poll(self->event_set,
+                                         self->config.busy_poll.usec,
+                                         self->config.busy_poll.budget, 1);
+        if (status == UCS_OK) {
+            self->busy_poll.active = 1;
+        } else if (status == UCS_ERR_UNSUPPORTED) {
+            ucs_diag("%s: busy polling of the event set is not supported, "
+                     "only the sockets are busy polled", self->if_name);
+            self->config.busy_poll.usec = 0;
+        } else {
+            goto err_cleanup_event_set;
+        }
     }
 
     status = uct_tcp_iface_listener_init(self);
@@ -788,6 +983,8 @@ static UCS_CLASS_INIT_FUNC(uct_tcp_iface_t, uct_md_h md, uct_worker_h worker,
 
 err_cleanup_event_set:
     ucs_event_set_cleanup(self->event_set);
+err_cleanup_rx_hdr_mpool:
+    ucs_mpool_cleanup(&self->rx_hdr_mpool, 1);
 err_cleanup_rx_mpool:
     ucs_mpool_cleanup(&self->rx_mpool, 1);
 err_cleanup_tx_mpool:
@@ -857,6 +1054,11 @@ static UCS_CLASS_CLEANUP_FUNC(uct_tcp_iface_t)
     ucs_conn_match_cleanup(&self->conn_match_ctx);
     UCS_PTR_MAP_DESTROY(tcp_ep, &self->ep_ptr_map);
 
+    if (self->rx_buf != NULL) {
+        ucs_mpool_put_inline(self->rx_buf);
+    }
+
+    ucs_mpool_cleanup(&self->rx_hdr_mpool, 1);
     ucs_mpool_cleanup(&self->rx_mpool, 1);
     ucs_mpool_cleanup(&self->tx_mpool, 1);
 
@@ -880,13 +1082,36 @@ static int uct_tcp_is_bridge(const char *if_name)
     return (stat(path, &st) == 0) && S_ISDIR(st.st_mode);
 }
 
+static ucs_status_t
+uct_tcp_add_device(uct_tl_device_resource_t **devices_p, unsigned *num_devices_p,
+                   const char *dev_name, uct_device_type_t dev_type,
+                   ucs_sys_device_t sys_dev)
+{
+    uct_tl_device_resource_t *devices;
+
+    devices = ucs_realloc(*devices_p, sizeof(*devices) * (*num_devices_p + 1),
+                          "tcp devices");
+    if (devices == NULL) {
+        return UCS_ERR_NO_MEMORY;
+    }
+
+    ucs_snprintf_zero(devices[*num_devices_p].name,
+                      sizeof(devices[*num_devices_p].name), "%s", dev_name);
+    devices[*num_devices_p].type       = dev_type;
+    devices[*num_devices_p].sys_device = sys_dev;
+
+    *devices_p = devices;
+    ++(*num_devices_p);
+    return UCS_OK;
+}
+
 ucs_status_t uct_tcp_query_devices(uct_md_h md,
                                    uct_tl_device_resource_t **devices_p,
                                    unsigned *num_devices_p)
 {
     uct_tcp_md_t *tcp_md               = ucs_derived_of(md, uct_tcp_md_t);
     const unsigned sys_device_priority = 10;
-    uct_tl_device_resource_t *devices, *tmp;
+    uct_tl_device_resource_t *devices;
     struct dirent **entries, **entry;
     unsigned num_devices;
     int is_active, i, n;
@@ -934,26 +1159,27 @@ ucs_status_t uct_tcp_query_devices(uct_md_h md,
             continue;
         }
 
-        tmp = ucs_realloc(devices, sizeof(*devices) * (num_devices + 1),
-                          "tcp devices");
-        if (tmp == NULL) {
-            ucs_free(devices);
-            status = UCS_ERR_NO_MEMORY;
-            goto out_release;
-        }
-        devices = tmp;
-
         sysfs_path = uct_tcp_iface_get_sysfs_path((*entry)->d_name,
                                                   path_buffer);
         sys_dev    = ucs_topo_get_sysfs_dev((*entry)->d_name, sysfs_path,
                                             sys_device_priority);
 
-        ucs_snprintf_zero(devices[num_devices].name,
-                          sizeof(devices[num_devices].name), "%s",
-                          (*entry)->d_name);
-        devices[num_devices].type       = UCT_DEVICE_TYPE_NET;
-        devices[num_devices].sys_device = sys_dev;
-        ++num_devices;
+        status = uct_tcp_add_device(&devices, &num_devices, (*entry)->d_name,
+                                    UCT_DEVICE_TYPE_NET, sys_dev);
+        if (status != UCS_OK) {
+            ucs_free(devices);
+            goto out_release;
+        }
+    }
+
+    if (tcp_md->config.unix_enable) {
+        status = uct_tcp_add_device(&devices, &num_devices,
+                                    UCT_TCP_UNIX_DEV_NAME, UCT_DEVICE_TYPE_SHM,
+                                    UCS_SYS_DEVICE_ID_UNKNOWN);
+        if (status != UCS_OK) {
+            ucs_free(devices);
+            goto out_release;
+        }
     }
 
     *num_devices_p = num_devices;
@@ -973,7 +1199,10 @@ out:
 int uct_tcp_keepalive_is_enabled(uct_tcp_iface_t *iface)
 {
 #ifdef UCT_TCP_EP_KEEPALIVE
-    return (iface->config.keepalive.idle != UCS_TIME_INFINITY) &&
+    /* Failure of a peer connected by a UNIX domain socket is detected when
+     * the socket is closed by the kernel */
+    return !uct_tcp_iface_is_unix(iface) &&
+           (iface->config.keepalive.idle != UCS_TIME_INFINITY) &&
            (iface->config.keepalive.cnt != UCS_ULUNITS_INF) &&
            (iface->config.keepalive.intvl != UCS_TIME_INFINITY);
 #else /* UCT_TCP_EP_KEEPALIVE */
@@ -24,6 +24,13 @@ static ucs_config_field_t uct_tcp_md_config_table[] = {
     {"BRIDGE_ENABLE", "n", "Enable using bridge devices",
      ucs_offsetof(uct_tcp_md_config_t, bridge_enable), UCS_CONFIG_TYPE_BOOL},
 
+    {"UNIX_ENABLE", "n",
+     "Enable the \"" UCT_TCP_UNIX_DEV_NAME "\" intra-node device, which uses UNIX\n"
+     "domain sockets instead of the TCP/IP stack for connections between\n"
+     "processes in the same network namespace. It can be used when shared\n"
+     "memory transports are not available.",
+     ucs_offsetof(uct_tcp_md_config_t, unix_enable), UCS_CONFIG_TYPE_BOOL},
+
     {NULL}
 };
 
@@ -76,6 +83,7 @@ uct_tcp_md_open(uct_component_t *component, const char *md_name,
     tcp_md->super.component      = &uct_tcp_component;
     tcp_md->config.af_prio_count = ucs_min(md_config->af_prio.count, 2);
     tcp_md->config.bridge_enable = md_config->bridge_enable;
+    tcp_md->config.unix_enable   = md_config->unix_enable;
 
     for (i = 0; i < tcp_md->config.af_prio_count; i++) {
         if (!strcasecmp(md_config->af_prio.af[i], "inet")) {
@@ -140,3 +140,39 @@ out:
     fclose(f);
     return UCS_OK;
 }
+
+ucs_status_t uct_tcp_sockaddr_get_port(const struct sockaddr *addr,
+                                       uint16_t *port_p)
+{
+    const struct sockaddr_un *sun_addr = (const struct sockaddr_un*)addr;
+
+    if (addr->sa_family != AF_UNIX) {
+        return ucs_sockaddr_get_port(addr, port_p);
+    }
+
+    if ((sun_addr->sun_path[0] != '\0') ||
+        (sscanf(sun_addr->sun_path + 1, UCT_TCP_UNIX_SOCKET_NAME_FMT,
+                port_p) != 1)) {
+        ucs_error("unexpected UNIX domain socket name: @%.*s",
+                  (int)sizeof(sun_addr->sun_path) - 1, sun_addr->sun_path + 1);
+        return UCS_ERR_INVALID_PARAM;
+    }
+
+    return UCS_OK;
+}
+
+ucs_status_t uct_tcp_sockaddr_set_port(struct sockaddr *addr, uint16_t port)
+{
+    struct sockaddr_un *sun_addr = (struct sockaddr_un*)addr;
+
+    if (addr->sa_family != AF_UNIX) {
+        return ucs_sockaddr_set_port(addr, port);
+    }
+
+    /* Use the abstract namespace, so there is no file to clean up and the name
+     * is released when the socket is closed */
+    memset(sun_addr->sun_path, 0, sizeof(sun_addr->sun_path));
+    ucs_snprintf_zero(sun_addr->sun_path + 1, sizeof(sun_addr->sun_path) - 1,
+                      UCT_TCP_UNIX_SOCKET_NAME_FMT, port);
+    return UCS_OK;
+}
@@ -13,6 +13,7 @@
 #include <common/test.h>
 #include <common/test_helpers.h>
 #include <pthread.h>
+#include <fstream>
 #include <sstream>
 #include <stdint.h>
 #include <dlfcn.h>
@@ -23,6 +24,8 @@ extern "C" {
 #include <ucm/malloc/malloc_hook.h>
 #include <ucm/bistro/bistro.h>
 #include <ucm/util/reloc.h>
+#include <ucm/util/sys.h>
+#include <ucs/sys/ptr_arith.h>
 #include <ucs/sys/sys.h>
 #ifdef HAVE_MALLOC_H
 #include <malloc.h>
@@ -621,11 +624,13 @@ public:
     malloc_hook_cplusplus() :
         m_mapped_size(0), m_unmapped_size(0),
         m_dynamic_mmap_config(ucm_global_opts.enable_dynamic_mmap_thresh),
+        m_hugepage_thresh(ucm_global_opts.malloc_hugepage_thresh),
         m_event(this) {
     }
 
     ~malloc_hook_cplusplus() {
         ucm_global_opts.enable_dynamic_mmap_thresh = m_dynamic_mmap_config;
+        ucm_global_opts.malloc_hugepage_thresh     = m_hugepage_thresh;
     }
 
     void set() {
@@ -702,6 +707,7 @@ protected:
     size_t m_mapped_size;
     size_t m_unmapped_size;
     int    m_dynamic_mmap_config;
+    size_t m_hugepage_thresh;
     mmap_event<malloc_hook_cplusplus> m_event;
 };
 
@@ -917,8 +923,48 @@ UCS_TEST_SKIP_COND_F(malloc_hook_cplusplus, dynamic_mmap_disable,
 
 extern "C" {
     int ucm_dlmallopt_get(int);
+    void *ucm_dlmalloc(size_t);
+    void ucm_dlfree(void*);
+    void *ucm_malloc_direct_mmap(size_t);
 };
 
+UCS_TEST_SKIP_COND_F(malloc_hook_cplusplus, hugepage_thresh,
+                     RUNNING_ON_VALGRIND) {
+    const size_t huge_page_size = ucm_get_huge_page_size();
+    const size_t page_size      = ucm_get_page_size();
+    size_t size;
+    void *small, *ptr;
+
+    if (huge_page_size == 0) {
+        UCS_TEST_SKIP_R("transparent huge pages are not supported");
+    }
+
+    ucm_global_opts.malloc_hugepage_thresh = huge_page_size;
+    size = (2 * huge_page_size) + page_size;
+
+    /* below the threshold, the chunk is mapped as usual */
+    ptr = ucm_malloc_direct_mmap(page_size);
+    ASSERT_NE(MAP_FAILED, ptr);
+    munmap(ptr, page_size);
+
+    ptr = ucm_malloc_direct_mmap(size);
+    ASSERT_NE(MAP_FAILED, ptr);
+    EXPECT_EQ(0ul, (uintptr_t)ptr % huge_page_size) << ptr;
+    memset(ptr, 0, size);
+    munmap(ptr, size);
+
+    /* large chunks from ptmalloc are mapped from a huge page boundary */
+    small = ucm_dlmalloc(small_alloc_size);
+    ASSERT_TRUE(small != NULL);
+    ptr = ucm_dlmalloc(size);
+    ASSERT_TRUE(ptr != NULL);
+    EXPECT_EQ(ucs_align_down_pow2((uintptr_t)ptr, page_size),
+              ucs_align_down_pow2((uintptr_t)ptr, huge_page_size)) << ptr;
+    memset(ptr, 0, size);
+    ucm_dlfree(ptr);
+    ucm_dlfree(small);
+}
+
 UCS_TEST_SKIP_COND_F(malloc_hook_cplusplus, mallopt,
                      skip_on_bistro_without_valgrind()) {
 
@@ -1239,6 +1285,161 @@ UCS_TEST_SKIP_COND_F(malloc_hook, test_event_unmap,
     EXPECT_TRUE(status == UCS_OK);
 }
 
+class malloc_hook_dispatch : public ucs::test {
+protected:
+    struct handler_ctx {
+        volatile int      active;
+        volatile uint32_t calls;
+        volatile uint32_t late_calls;
+    };
+
+    typedef struct {
+        pthread_barrier_t *barrier;
+        volatile int      *stop;
+        size_t            count;
+    } thread_args_t;
+
+    static void event_callback(ucm_event_type_t event_type, ucm_event_t *event,
+                               void *arg)
+    {
+        handler_ctx *ctx = reinterpret_cast<handler_ctx*>(arg);
+
+        if (!ctx->active) {
+            ucs_atomic_add32(&ctx->late_calls, 1);
+        }
+        ucs_atomic_add32(&ctx->calls, 1);
+    }
+
+    static void null_callback(ucm_event_type_t event_type, ucm_event_t *event,
+                              void *arg)
+    {
+    }
+
+    /* Map and unmap a page until stopped, or for the given number of times */
+    static void *mmap_thread_func(void *arg)
+    {
+        thread_args_t *args = reinterpret_cast<thread_args_t*>(arg);
+        size_t page_size    = ucs_get_page_size();
+        size_t i;
+        void *ptr;
+
+        pthread_barrier_wait(args->barrier);
+        for (i = 0; (args->stop == NULL) ? (i < args->count) : !*args->stop;
+             ++i) {
+            ptr = mmap(NULL, page_size, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (ptr != MAP_FAILED) {
+                munmap(ptr, page_size);
+            }
+        }
+        return NULL;
+    }
+
+    void start_threads(unsigned num_threads, thread_args_t *args,
+                       std::vector<pthread_t> &threads)
+    {
+        threads.resize(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            ASSERT_EQ(0, pthread_create(&threads[i], NULL, mmap_thread_func,
+                                        args));
+        }
+    }
+
+    void join_threads(std::vector<pthread_t> &threads)
+    {
+        for (size_t i = 0; i < threads.size(); ++i) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+};
+
+UCS_TEST_SKIP_COND_F(malloc_hook_dispatch, unset_while_dispatching,
+                     RUNNING_ON_VALGRIND) {
+    const unsigned num_threads = 4;
+    const unsigned num_iters   = 200 / ucs::test_time_multiplier();
+    std::vector<handler_ctx> ctxs(num_iters);
+    std::vector<pthread_t> threads;
+    pthread_barrier_t barrier;
+    volatile int stop = 0;
+    thread_args_t args;
+    ucs_status_t status;
+    ucs_time_t deadline;
+
+    pthread_barrier_init(&barrier, NULL, num_threads + 1);
+    args.barrier = &barrier;
+    args.stop    = &stop;
+    args.count   = 0;
+    start_threads(num_threads, &args, threads);
+    pthread_barrier_wait(&barrier);
+
+    for (unsigned i = 0; i < num_iters; ++i) {
+        handler_ctx *ctx = &ctxs[i];
+
+        ctx->active     = 1;
+        ctx->calls      = 0;
+        ctx->late_calls = 0;
+        status = ucm_set_event_handler(UCM_EVENT_VM_MAPPED |
+                                       UCM_EVENT_VM_UNMAPPED, i % 3,
+                                       event_callback, ctx);
+        ASSERT_UCS_OK(status);
+
+        deadline = ucs_get_time() + ucs_time_from_sec(1.0);
+        while ((ctx->calls == 0) && (ucs_get_time() < deadline)) {
+            sched_yield();
+        }
+
+        /* The callback must not be called after unset returns */
+        ucm_unset_event_handler(UCM_EVENT_VM_MAPPED | UCM_EVENT_VM_UNMAPPED,
+                                event_callback, ctx);
+        ctx->active = 0;
+    }
+
+    stop = 1;
+    join_threads(threads);
+    pthread_barrier_destroy(&barrier);
+
+    for (unsigned i = 0; i < num_iters; ++i) {
+        EXPECT_GT(ctxs[i].calls, 0u) << "iteration " << i;
+        EXPECT_EQ(0u, ctxs[i].late_calls) << "iteration " << i;
+    }
+}
+
+UCS_TEST_SKIP_COND_F(malloc_hook_dispatch, mmap_munmap_perf,
+                     RUNNING_ON_VALGRIND ||
+                     (ucs::test_time_multiplier() > 1)) {
+    const size_t count = 10000;
+    std::vector<pthread_t> threads;
+    pthread_barrier_t barrier;
+    thread_args_t args;
+    ucs_status_t status;
+    ucs_time_t start_time, elapsed;
+
+    status = ucm_set_event_handler(UCM_EVENT_VM_MAPPED | UCM_EVENT_VM_UNMAPPED,
+                                   0, null_callback, NULL);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned num_threads = 1; num_threads <= 64; num_threads *= 2) {
+        pthread_barrier_init(&barrier, NULL, num_threads + 1);
+        args.barrier = &barrier;
+        args.stop    = NULL;
+        args.count   = count;
+        start_threads(num_threads, &args, threads);
+
+        pthread_barrier_wait(&barrier);
+        start_time = ucs_get_time();
+        join_threads(threads);
+        elapsed = ucs_get_time() - start_time;
+        pthread_barrier_destroy(&barrier);
+
+        UCS_TEST_MESSAGE << num_threads << " threads: "
+                         << ucs_time_to_nsec(elapsed) / count
+                         << " nsec per mmap+munmap in each thread";
+    }
+
+    ucm_unset_event_handler(UCM_EVENT_VM_MAPPED | UCM_EVENT_VM_UNMAPPED,
+                            null_callback, NULL);
+}
+
 class memtype_hooks : public ucs::test_with_param<ucs_memory_type_t> {
 public:
     void mem_event(ucm_event_type_t event_type, ucm_event_t *event)
@@ -1548,3 +1749,65 @@ UCS_MT_TEST_F(malloc_hook_dlopen, dlopen_mt_with_memtype, 2) {
 
     event.unset();
 }
+
+UCS_TEST_SKIP_COND_F(malloc_hook_dlopen, dlopen_many_libs,
+                     (ucs::test_time_multiplier() > 1)) {
+    typedef void (*fire_mmap_f)(void);
+
+    const int num_libs = 200;
+    char dir[]         = "/tmp/ucm_dlopen_XXXXXX";
+    std::vector<std::string> paths;
+    std::vector<void*> libs;
+    ucs_time_t start_time, elapsed;
+    ucs_status_t status;
+    fire_mmap_f fire;
+
+    /* Load many distinct copies of the same library, like an application
+     * which loads lots of plugins, each one has to be patched */
+    ASSERT_TRUE(mkdtemp(dir) != NULL) << strerror(errno);
+
+    std::ifstream src(get_lib_path_do_mmap().c_str(), std::ios::binary);
+    ASSERT_TRUE(src.good());
+    std::string image((std::istreambuf_iterator<char>(src)),
+                      std::istreambuf_iterator<char>());
+
+    for (int i = 0; i < num_libs; ++i) {
+        std::stringstream ss;
+        ss << dir << "/libdlopen_test_" << i << ".so";
+        paths.push_back(ss.str());
+        std::ofstream dst(paths.back().c_str(), std::ios::binary);
+        dst << image;
+    }
+
+    mmap_event<malloc_hook> event(this);
+    status = event.set(UCM_EVENT_VM_MAPPED);
+    ASSERT_UCS_OK(status);
+
+    start_time = ucs_get_time();
+    for (int i = 0; i < num_libs; ++i) {
+        libs.push_back(dlopen(paths[i].c_str(), RTLD_NOW));
+        EXPECT_TRUE(libs.back() != NULL) << dlerror();
+    }
+    elapsed = ucs_get_time() - start_time;
+
+    UCS_TEST_MESSAGE << num_libs << " libraries: "
+                     << ucs_time_to_usec(elapsed) / num_libs
+                     << " usec per dlopen";
+
+    /* Events are reported from the last loaded library */
+    fire = (fire_mmap_f)dlsym(libs.back(), "fire_mmap");
+    ASSERT_TRUE(fire != NULL);
+    m_got_event = 0;
+    fire();
+    EXPECT_GT(m_got_event, 0);
+
+    event.unset();
+
+    for (int i = 0; i < num_libs; ++i) {
+        if (libs[i] != NULL) {
+            dlclose(libs[i]);
+        }
+        unlink(paths[i].c_str());
+    }
+    rmdir(dir);
+}
@@ -507,7 +507,7 @@ protected:
     {
         ucp_ep_config_t *cfg = ucp_ep_config(sender().ep());
         const ucp_proto_config_t *proto_config;
-        ucp_proto_select_elem_t value;
+        ucs_swiss_hash_iter_t iter;
 
         /* Skip proto_select hash map check for HWTM since eager has certain
            max_frag threshold in that case and there is no reliable way
@@ -517,7 +517,9 @@ protected:
             UCS_TEST_SKIP_R("Skip EP RNDV_THRESH check for HWTM");
         }
 
-        kh_foreach_value(cfg->proto_select.hash, value, {
+        ucs_swiss_hash_for_each(&cfg->proto_select.hash, iter) {
+            const ucp_proto_select_elem_t &value =
+                    ucs_swiss_hash_value(&cfg->proto_select.hash, iter);
             /* Find index of the corresponding ucp_proto_threshold_elem_t
              * to handle the given message size */
             unsigned idx = 0;
@@ -533,7 +535,7 @@ protected:
             } else {
                 EXPECT_EQ(nullptr, strstr(proto_config->proto->name, "rndv"));
             }
-        });
+        }
     }
 
     void check_rndv_threshold(size_t cfg_thresh)
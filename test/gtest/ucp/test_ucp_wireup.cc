@@ -1367,6 +1367,45 @@ UCS_TEST_P(select_transport_rma_bw, select_rc, "NUM_EPS=56", "NUM_PPN=28")
 
 UCP_INSTANTIATE_TEST_CASE_TLS(select_transport_rma_bw, tcp_ib, "tcp,ib")
 
+class select_transport_tcp_paths : public test_ucp_wireup {
+public:
+    static void get_test_variants(std::vector<ucp_test_variant> &variants)
+    {
+        add_variant_with_value(variants, UCP_FEATURE_TAG, TEST_TAG, "tag");
+    }
+
+    void init() override
+    {
+        modify_config("TCP_NUM_PATHS", "2", SETENV_IF_NOT_EXIST);
+        test_ucp_wireup::init();
+    }
+};
+
+UCS_TEST_P(select_transport_tcp_paths, stripe, "MAX_RNDV_RAILS=4")
+{
+    sender().connect(&receiver(), get_ep_params());
+    const auto config = ucp_ep_config(sender().ep());
+    bool extra_path   = false;
+
+    for (int i = 0; i < config->key.num_lanes; ++i) {
+        const auto lane = config->key.rma_bw_lanes[i];
+        if (lane == UCP_NULL_LANE) {
+            break;
+        }
+
+        /* Additional connections over the same device are used for large
+         * messages */
+        extra_path = extra_path || (config->key.lanes[lane].path_index > 0);
+    }
+
+    EXPECT_TRUE(extra_path);
+    send_recv(sender().ep(), receiver().worker(), receiver().ep(),
+              BUFFER_LENGTH, 1);
+    flush_worker(sender());
+}
+
+UCP_INSTANTIATE_TEST_CASE_TLS(select_transport_tcp_paths, tcp, "tcp")
+
 class test_ucp_wireup_fallback_amo : public test_ucp_wireup {
 protected:
     void init() {
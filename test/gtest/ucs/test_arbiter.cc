@@ -226,6 +226,34 @@ protected:
         return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
     }
 
+    static ucs_arbiter_cb_result_t record_cb(ucs_arbiter_t *arbiter,
+                                             ucs_arbiter_group_t *group,
+                                             ucs_arbiter_elem_t *elem,
+                                             void *arg)
+    {
+        test_arbiter *self = static_cast<test_arbiter*>(arg);
+
+        self->m_order.push_back(elem);
+        return UCS_ARBITER_CB_RESULT_REMOVE_ELEM;
+    }
+
+    /* push a priority element to the dispatched group, once */
+    static ucs_arbiter_cb_result_t push_prio_cb(ucs_arbiter_t *arbiter,
+                                                ucs_arbiter_group_t *group,
+                                                ucs_arbiter_elem_t *elem,
+                                                void *arg)
+    {
+        test_arbiter *self = static_cast<test_arbiter*>(arg);
+
+        if (self->m_prio_elem != NULL) {
+            ucs_arbiter_group_push_prio_elem(group, self->m_prio_elem);
+            ucs_arbiter_group_schedule(arbiter, group);
+            self->m_prio_elem = NULL;
+        }
+
+        return record_cb(arbiter, group, elem, arg);
+    }
+
     void test_move_groups(int N, int nelems, bool push_head = false)
     {
 
@@ -268,6 +296,8 @@ protected:
     ucs_arbiter_t         m_arb1;
     ucs_arbiter_t         m_arb2;
     int                   m_count;
+    std::vector<ucs_arbiter_elem_t*> m_order;
+    ucs_arbiter_elem_t    *m_prio_elem;
 };
 
 
@@ -765,6 +795,105 @@ UCS_TEST_F(test_arbiter, result_stop) {
     delete [] elems;
 }
 
+UCS_TEST_F(test_arbiter, prio_elems) {
+    const int N      = 4;
+    const int nelems = 3;
+    ucs_arbiter_group_t groups[N];
+    ucs_arbiter_elem_t elems[N * nelems];
+    ucs_arbiter_elem_t prio_elems[2];
+
+    ucs_arbiter_init(&m_arb1);
+    prepare_groups(groups, elems, N, nelems, false);
+
+    /* add priority elements to an already scheduled group */
+    for (int i = 0; i < 2; ++i) {
+        ucs_arbiter_elem_init(&prio_elems[i]);
+        ucs_arbiter_group_push_prio_elem(&groups[2], &prio_elems[i]);
+    }
+    ucs_arbiter_group_schedule(&m_arb1, &groups[2]);
+    EXPECT_TRUE(ucs_arbiter_group_has_prio(&groups[2]));
+    EXPECT_EQ(nelems + 2, ucs_arbiter_group_num_elems(&groups[2]));
+
+    m_order.clear();
+    ucs_arbiter_dispatch(&m_arb1, 1, record_cb, this);
+    ASSERT_EQ(N * nelems + 2, m_order.size());
+
+    /* priority elements are dispatched first, in FIFO order */
+    EXPECT_EQ(&prio_elems[0], m_order[0]);
+    EXPECT_EQ(&prio_elems[1], m_order[1]);
+    EXPECT_FALSE(ucs_arbiter_group_has_prio(&groups[2]));
+
+    /* then regular elements in round-robin order, where the group which had
+     * the priority elements was moved to the tail */
+    const int group_order[N] = {0, 1, 3, 2};
+    for (int i = 0; i < N * nelems; ++i) {
+        EXPECT_EQ(&elems[group_order[i % N] * nelems + (i / N)],
+                  m_order[i + 2]) << i;
+    }
+
+    ucs_arbiter_cleanup(&m_arb1);
+}
+
+UCS_TEST_F(test_arbiter, prio_elem_from_dispatch) {
+    const int N      = 2;
+    const int nelems = 2;
+    ucs_arbiter_group_t groups[N];
+    ucs_arbiter_elem_t elems[N * nelems];
+    ucs_arbiter_elem_t prio_elem;
+
+    ucs_arbiter_init(&m_arb1);
+    prepare_groups(groups, elems, N, nelems, false);
+
+    ucs_arbiter_elem_init(&prio_elem);
+    m_prio_elem = &prio_elem;
+
+    m_order.clear();
+    ucs_arbiter_dispatch(&m_arb1, 1, push_prio_cb, this);
+    ASSERT_EQ(N * nelems + 1, m_order.size());
+
+    /* the priority element pushed while dispatching group 0 overtakes group 1 */
+    EXPECT_EQ(&elems[0], m_order[0]);
+    EXPECT_EQ(&prio_elem, m_order[1]);
+    EXPECT_EQ(&elems[2], m_order[2]);
+    EXPECT_EQ(&elems[1], m_order[3]);
+    EXPECT_EQ(&elems[3], m_order[4]);
+
+    ucs_arbiter_cleanup(&m_arb1);
+}
+
+UCS_TEST_F(test_arbiter, prio_elems_purge) {
+    ucs_arbiter_group_t group;
+    arb_elem elems[4];
+
+    ucs_arbiter_init(&m_arb1);
+    ucs_arbiter_group_init(&group);
+    for (int i = 0; i < 4; ++i) {
+        ucs_arbiter_elem_init(&elems[i].elem);
+        elems[i].release = (i % 2) == 0;
+    }
+
+    ucs_arbiter_group_push_elem(&group, &elems[0].elem);
+    ucs_arbiter_group_push_elem(&group, &elems[1].elem);
+    ucs_arbiter_group_push_prio_elem(&group, &elems[2].elem);
+    ucs_arbiter_group_push_prio_elem(&group, &elems[3].elem);
+    ucs_arbiter_group_schedule(&m_arb1, &group);
+
+    /* remove first priority element and first regular element */
+    m_count = 0;
+    ucs_arbiter_group_purge(&m_arb1, &group, purge_cond_cb, this);
+    EXPECT_EQ(2, m_count);
+    EXPECT_TRUE(ucs_arbiter_group_has_prio(&group));
+
+    m_order.clear();
+    ucs_arbiter_dispatch(&m_arb1, 1, record_cb, this);
+    ASSERT_EQ(2u, m_order.size());
+    EXPECT_EQ(&elems[3].elem, m_order[0]);
+    EXPECT_EQ(&elems[1].elem, m_order[1]);
+
+    ucs_arbiter_group_cleanup(&group);
+    ucs_arbiter_cleanup(&m_arb1);
+}
+
 class test_arbiter_resched_from_dispatch : public ucs::test {
 public:
     virtual void init() {
@@ -619,6 +619,58 @@ UCS_TEST_F(test_config, performance) {
     }
 }
 
+UCS_TEST_F(test_config, memoize) {
+    const unsigned count = 1000;
+    ucs_config_global_list_entry_t entry;
+    ucs_time_t start_time, cold_time;
+    car_opts_t opts;
+
+    entry.table  = car_opts_table;
+    entry.name   = "cars";
+    entry.prefix = NULL;
+    entry.size   = sizeof(car_opts_t);
+    entry.flags  = 0;
+
+    /* Changes to the environment must not be hidden by memoized results */
+    for (unsigned i = 0; i < 3; ++i) {
+        {
+            ucs::scoped_setenv env1("UCX_COLOR", "white");
+            ASSERT_UCS_OK(ucs_config_parser_fill_opts(&opts, &entry,
+                                                      UCS_DEFAULT_ENV_PREFIX,
+                                                      0));
+            EXPECT_EQ(COLOR_WHITE, opts.color);
+            ucs_config_parser_release_opts(&opts, car_opts_table);
+        }
+
+        ASSERT_UCS_OK(ucs_config_parser_fill_opts(&opts, &entry,
+                                                  UCS_DEFAULT_ENV_PREFIX, 0));
+        EXPECT_EQ(COLOR_RED, opts.color);
+        ucs_config_parser_release_opts(&opts, car_opts_table);
+    }
+
+    /* Setting a value invalidates memoized results */
+    start_time = ucs_get_time();
+    ASSERT_UCS_OK(ucs_config_parser_set_value(&opts, car_opts_table, NULL,
+                                              "COLOR", "blue"));
+    ASSERT_UCS_OK(ucs_config_parser_fill_opts(&opts, &entry,
+                                              UCS_DEFAULT_ENV_PREFIX, 0));
+    cold_time = ucs_get_time() - start_time;
+    EXPECT_EQ(COLOR_RED, opts.color);
+    ucs_config_parser_release_opts(&opts, car_opts_table);
+
+    start_time = ucs_get_time();
+    for (unsigned i = 0; i < count; ++i) {
+        ASSERT_UCS_OK(ucs_config_parser_fill_opts(&opts, &entry,
+                                                  UCS_DEFAULT_ENV_PREFIX, 0));
+        ucs_config_parser_release_opts(&opts, car_opts_table);
+    }
+
+    UCS_TEST_MESSAGE << "first parse: " << ucs_time_to_usec(cold_time)
+                     << " usec, memoized: "
+                     << ucs_time_to_usec(ucs_get_time() - start_time) / count
+                     << " usec";
+}
+
 UCS_TEST_F(test_config, unused) {
     ucs::ucx_env_cleanup env_cleanup;
 
@@ -1349,6 +1349,48 @@ UCS_TEST_F(test_datatype_ptr_map, unsafe_put) {
     UCS_PTR_MAP_DESTROY(unsafe_put, &ptr_map);
 }
 
+UCS_TEST_F(test_datatype_ptr_map, stale_key) {
+    UCS_PTR_MAP_T(unsafe_put) ptr_map;
+    std::vector<ucs_ptr_map_key_t> keys;
+    std_vec_t std_vec(vec_size, 0);
+    ucs_ptr_map_key_t ptr_key, new_key;
+    ucs_status_t status;
+    void *value;
+
+    ASSERT_UCS_OK(UCS_PTR_MAP_INIT(unsafe_put, &ptr_map));
+
+    for (auto it = std_vec.begin(); it != std_vec.end(); ++it) {
+        ASSERT_UCS_OK(UCS_PTR_MAP_PUT(unsafe_put, &ptr_map, &(*it), 1,
+                                      &ptr_key));
+        keys.push_back(ptr_key);
+    }
+
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+        ASSERT_UCS_OK(UCS_PTR_MAP_DEL(unsafe_put, &ptr_map, *it));
+    }
+
+    /* Removed keys are not found, even after their slots are reused */
+    for (auto it = keys.begin(); it != keys.end(); ++it) {
+        status = UCS_PTR_MAP_GET(unsafe_put, &ptr_map, *it, 0, &value);
+        EXPECT_EQ(UCS_ERR_NO_ELEM, status);
+
+        ASSERT_UCS_OK(UCS_PTR_MAP_PUT(unsafe_put, &ptr_map, &std_vec[0], 1,
+                                      &new_key));
+        EXPECT_NE(*it, new_key);
+
+        status = UCS_PTR_MAP_GET(unsafe_put, &ptr_map, *it, 0, &value);
+        EXPECT_EQ(UCS_ERR_NO_ELEM, status);
+        status = UCS_PTR_MAP_DEL(unsafe_put, &ptr_map, *it);
+        EXPECT_EQ(UCS_ERR_NO_ELEM, status);
+
+        ASSERT_UCS_OK(UCS_PTR_MAP_GET(unsafe_put, &ptr_map, new_key, 1,
+                                      &value));
+        EXPECT_EQ(&std_vec[0], value);
+    }
+
+    UCS_PTR_MAP_DESTROY(unsafe_put, &ptr_map);
+}
+
 class test_datatype_ptr_map_safe : public test_datatype_ptr_map {
 public:
     test_datatype_ptr_map_safe()
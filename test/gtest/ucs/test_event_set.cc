@@ -279,6 +279,38 @@ UCS_TEST_P(test_event_set, ucs_event_set_trig_modes) {
     event_set_cleanup();
 }
 
+UCS_TEST_P(test_event_set, ucs_event_set_busy_poll) {
+    void *arg[] = { (void*)UCS_EVENT_SET_EXTRA_STRING,
+                    (void*)&UCS_EVENT_SET_EXTRA_NUM };
+    ucs_status_t status;
+
+    event_set_init(event_set_read_func);
+    event_set_ctl(EVENT_SET_OP_ADD, m_pipefd[0],
+                  UCS_EVENT_SET_EVREAD);
+
+    status = ucs_event_set_busy_poll(m_event_set, 10, 8, 1);
+    if (status == UCS_ERR_UNSUPPORTED) {
+        UCS_TEST_MESSAGE << "epoll busy polling is not supported";
+    } else {
+        ASSERT_UCS_OK(status);
+    }
+
+    thread_barrier();
+
+    /* Events are reported while busy polling */
+    event_set_wait(1u, 0, event_set_func1, arg);
+
+    status = ucs_event_set_busy_poll(m_event_set, 0, 0, 0);
+    if (status != UCS_ERR_UNSUPPORTED) {
+        ASSERT_UCS_OK(status);
+    }
+
+    event_set_wait(0u, 0, event_set_func3, NULL);
+
+    event_set_ctl(EVENT_SET_OP_DEL, m_pipefd[0], 0);
+    event_set_cleanup();
+}
+
 INSTANTIATE_TEST_SUITE_P(ext_fd, test_event_set,
                         ::testing::Values(static_cast<int>(
                                               UCS_EVENT_SET_EXTERNAL_FD)));
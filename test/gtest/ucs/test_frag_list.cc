@@ -333,3 +333,63 @@ UCS_TEST_F(frag_list, random_arrival) {
         last_sn = out->sn;
     }
 }
+
+/**
+ * Random reordering within a bounded window, with sequence number wrap-around.
+ * Measures the insertion time when there are many holes.
+ */
+UCS_TEST_SKIP_COND_F(frag_list, random_reorder_perf,
+                     (ucs::test_time_multiplier() > 1)) {
+    const int window      = 4096;
+    const int num_windows = 100 / ucs::test_time_multiplier();
+    std::vector<pkt> pkts(window);
+    std::vector<int> idx(window);
+    ucs_frag_list_sn_t last_sn = 0;
+    ucs_frag_list_sn_t base_sn = 1;
+    ucs_frag_list_elem_t *elem;
+    uint32_t max_holes         = 0;
+    size_t pulled              = 0;
+    ucs_time_t elapsed         = 0;
+    ucs_time_t start_time;
+    ucs_frag_list_sn_t sn;
+    int err, i, w;
+
+    for (w = 0; w < num_windows; ++w) {
+        permute_array(&idx[0], window);
+        for (i = 0; i < window; ++i) {
+            sn              = base_sn + idx[i];
+            pkts[idx[i]].sn = sn;
+
+            start_time = ucs_get_time();
+            err        = ucs_frag_list_insert(&m_frags, &pkts[idx[i]].elem, sn);
+            elapsed   += ucs_get_time() - start_time;
+            ASSERT_NE(UCS_FRAG_LIST_INSERT_DUP, err);
+            ASSERT_NE(UCS_FRAG_LIST_INSERT_FAIL, err);
+
+            if ((err == UCS_FRAG_LIST_INSERT_FAST) ||
+                (err == UCS_FRAG_LIST_INSERT_FIRST)) {
+                ASSERT_EQ((ucs_frag_list_sn_t)(last_sn + 1), sn);
+                last_sn = sn;
+                ++pulled;
+            }
+
+            max_holes = ucs_max(m_frags.list_count, max_holes);
+            while ((elem = ucs_frag_list_pull(&m_frags)) != NULL) {
+                pkt *out = ucs_container_of(elem, pkt, elem);
+                ASSERT_EQ((ucs_frag_list_sn_t)(last_sn + 1), out->sn);
+                last_sn = out->sn;
+                ++pulled;
+            }
+        }
+
+        ASSERT_TRUE(ucs_frag_list_empty(&m_frags));
+        base_sn += window;
+    }
+
+    EXPECT_EQ((size_t)window * num_windows, pulled);
+    ucs_frag_list_dump(&m_frags, 0);
+
+    UCS_TEST_MESSAGE << "max_holes=" << max_holes << " "
+                     << ucs_time_to_nsec(elapsed) / (window * num_windows)
+                     << " nsec per insert";
+}
@@ -7,6 +7,7 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/datastruct/mpool.h>
+#include <ucs/sys/sys.h>
 }
 
 #include <limits.h>
@@ -367,6 +368,44 @@ UCS_TEST_F(test_mpool, leak_check) {
     EXPECT_EQ(5u, leak_count);
 }
 
+UCS_TEST_F(test_mpool, numa_bind) {
+    ucs_numa_node_t node = ucs_numa_node_of_current_cpu();
+    ucs_mpool_ops_t ops  = {ucs_mpool_chunk_mmap, ucs_mpool_chunk_munmap,
+                            NULL, NULL, NULL};
+    std::vector<void*> objs;
+    ucs_mpool_params_t mp_params;
+    ucs_mpool_t mp;
+    ucs_status_t status;
+
+    if ((node == UCS_NUMA_NODE_UNDEFINED) ||
+        (ucs_numa_node_of_address(&node) == UCS_NUMA_NODE_UNDEFINED)) {
+        UCS_TEST_SKIP_R("memory policy is not supported");
+    }
+
+    ucs_mpool_params_reset(&mp_params);
+    mp_params.elem_size       = ucs_get_page_size();
+    mp_params.elems_per_chunk = 64;
+    mp_params.ops             = &ops;
+    mp_params.name            = "tests";
+    mp_params.numa_node       = node;
+    status = ucs_mpool_init(&mp_params, &mp);
+    ASSERT_UCS_OK(status);
+
+    for (unsigned i = 0; i < mp_params.elems_per_chunk; ++i) {
+        void *obj = ucs_mpool_get(&mp);
+        ASSERT_TRUE(obj != NULL);
+        memset(obj, 0, mp_params.elem_size);
+        EXPECT_EQ(node, ucs_numa_node_of_address(obj));
+        objs.push_back(obj);
+    }
+
+    for (size_t i = 0; i < objs.size(); ++i) {
+        ucs_mpool_put(objs[i]);
+    }
+
+    ucs_mpool_cleanup(&mp, 1);
+}
+
 class test_mpool_grow : public test_mpool {
 public:
     void run_grow_test(double grow_factor,
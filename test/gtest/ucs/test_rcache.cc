@@ -7,6 +7,7 @@
 #include <common/test.h>
 extern "C" {
 #include <ucs/arch/atomic.h>
+#include <ucs/datastruct/queue.h>
 #include <ucs/sys/math.h>
 #include <ucs/stats/stats.h>
 #include <ucs/memory/rcache.h>
@@ -26,7 +27,9 @@ get_default_rcache_params(void *context, const ucs_rcache_ops_t *ops)
                                   context,
                                   0,
                                   ULONG_MAX,
-                                  SIZE_MAX};
+                                  SIZE_MAX,
+                                  0,
+                                  ULONG_MAX};
 
     return params;
 }
@@ -872,6 +875,159 @@ UCS_TEST_F(test_rcache_with_limit, by_size_inuse) {
     free(ptr1);
 }
 
+class test_rcache_gc_batch : public test_rcache {
+protected:
+    static const unsigned gc_batch = 2;
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        /* Trigger async cleanup only when GC batch limit is reached */
+        params.max_unreleased      = SIZE_MAX;
+        params.gc_batch            = gc_batch;
+        return params;
+    }
+};
+
+UCS_TEST_F(test_rcache_gc_batch, async_dereg) {
+    static const unsigned num_regions = 10;
+    const size_t size                 = ucs_get_page_size();
+    std::vector<void*> mems;
+    ucs_time_t deadline;
+    region *r;
+
+    for (unsigned i = 0; i < num_regions; ++i) {
+        mems.push_back(alloc_pages(size, PROT_READ | PROT_WRITE));
+        put(get(mems.back(), size));
+    }
+
+    /* Invalidated regions are moved to GC list and not deregistered */
+    for (unsigned i = 0; i < num_regions; ++i) {
+        munmap(mems[i], size);
+    }
+    EXPECT_EQ(num_regions, m_reg_count);
+
+    /* A registration releases at most gc_batch regions, and the rest are
+     * released by the async thread */
+    void *mem = alloc_pages(size, PROT_READ | PROT_WRITE);
+    r         = get(mem, size);
+    EXPECT_GE(num_regions + 1 - gc_batch, m_reg_count);
+
+    deadline = ucs_get_time() + ucs_time_from_sec(10.0);
+    while ((m_reg_count > 1) && (ucs_get_time() < deadline)) {
+        usleep(1000);
+    }
+    EXPECT_EQ(1u, m_reg_count);
+
+    put(r);
+    munmap(mem, size);
+}
+
+class test_rcache_uffd : public test_rcache {
+protected:
+    virtual void init()
+    {
+        test_rcache::init();
+        if (!m_rcache->uffd) {
+            UCS_TEST_SKIP_R("userfaultfd is not supported");
+        }
+    }
+
+    virtual ucs_rcache_params_t rcache_params()
+    {
+        ucs_rcache_params_t params = test_rcache::rcache_params();
+        params.flags              |= UCS_RCACHE_FLAG_UFFD_EVENTS;
+        return params;
+    }
+
+    /* Events are handled by another thread, so wait for the region to be
+     * removed from the page table */
+    void wait_for_invalidate(region *r)
+    {
+        ucs_time_t deadline = ucs_get_time() + ucs_time_from_sec(10.0);
+
+        while ((r->super.flags & UCS_RCACHE_REGION_FLAG_PGTABLE) &&
+               (ucs_get_time() < deadline)) {
+            usleep(1000);
+        }
+        EXPECT_FALSE(r->super.flags & UCS_RCACHE_REGION_FLAG_PGTABLE);
+    }
+};
+
+UCS_TEST_F(test_rcache_uffd, munmap) {
+    const size_t size = 16 * ucs_get_page_size();
+    void *mem         = alloc_pages(size, PROT_READ | PROT_WRITE);
+    region *r1, *r2;
+
+    r1 = get(mem, size);
+    r2 = get(mem, size);
+    EXPECT_EQ(r1, r2);
+    put(r2);
+
+    munmap(mem, size);
+    wait_for_invalidate(r1);
+    put(r1);
+    EXPECT_EQ(0u, m_reg_count);
+}
+
+UCS_TEST_F(test_rcache_uffd, madvise) {
+    const size_t size = 16 * ucs_get_page_size();
+    void *mem         = alloc_pages(size, PROT_READ | PROT_WRITE);
+    region *r1;
+
+    r1 = get(mem, size);
+    /* Registration locks the memory, which makes MADV_DONTNEED fail */
+    munlock(mem, size);
+    ASSERT_EQ(0, madvise((char*)mem + ucs_get_page_size(),
+                         ucs_get_page_size(), MADV_DONTNEED));
+    wait_for_invalidate(r1);
+    put(r1);
+
+    munmap(mem, size);
+}
+
+UCS_TEST_F(test_rcache_uffd, mremap) {
+    const size_t size = 16 * ucs_get_page_size();
+    void *mem         = alloc_pages(size, PROT_READ | PROT_WRITE);
+    void *dest        = alloc_pages(size, PROT_NONE);
+    region *r1;
+    void *new_mem;
+
+    r1      = get(mem, size);
+    new_mem = mremap(mem, size, size, MREMAP_MAYMOVE | MREMAP_FIXED, dest);
+    ASSERT_EQ(dest, new_mem) << strerror(errno);
+    wait_for_invalidate(r1);
+    put(r1);
+
+    munmap(new_mem, size);
+}
+
+UCS_TEST_F(test_rcache_uffd, file_backed) {
+    const size_t size = 4 * ucs_get_page_size();
+    char path[]       = "/tmp/test_rcache_uffd.XXXXXX";
+    region *r1;
+    void *mem;
+    int fd;
+
+    fd = mkstemp(path);
+    ASSERT_GE(fd, 0) << strerror(errno);
+    unlink(path);
+    ASSERT_EQ(0, ftruncate(fd, size));
+
+    mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ASSERT_NE(MAP_FAILED, mem) << strerror(errno);
+
+    /* Unmapping a regular file mapping cannot be tracked, so the region is
+     * released as soon as it is not used */
+    r1 = get(mem, size);
+    EXPECT_FALSE(r1->super.flags & UCS_RCACHE_REGION_FLAG_PGTABLE);
+    put(r1);
+    EXPECT_EQ(0u, m_reg_count);
+
+    munmap(mem, size);
+    close(fd);
+}
+
 #ifdef ENABLE_STATS
 class test_rcache_stats : public test_rcache {
 protected:
@@ -1055,6 +1211,41 @@ UCS_TEST_F(test_rcache_stats, hits_slow) {
     put(r2);
     munmap(mem2, size1);
 }
+
+UCS_TEST_F(test_rcache_stats, unmap_merge) {
+    static const int num_pages = 16;
+    size_t page_size           = ucs_get_page_size();
+    size_t size1               = num_pages * page_size;
+    region *r1;
+    void *mem1, *mem2;
+    int i;
+
+    mem1 = alloc_pages(size1, PROT_READ|PROT_WRITE);
+    r1   = get(mem1, size1);
+    put(r1);
+
+    /* release the memory page by page while the page table is locked, so the
+     * events are queued and merged into a single invalidation entry */
+    pthread_rwlock_rdlock(&m_rcache->pgt_lock);
+    for (i = 0; i < num_pages; ++i) {
+        munmap((char*)mem1 + (i * page_size), page_size);
+    }
+    EXPECT_EQ(1u, ucs_queue_length(&m_rcache->inv_q));
+    pthread_rwlock_unlock(&m_rcache->pgt_lock);
+
+    EXPECT_EQ(num_pages, get_counter(UCS_RCACHE_UNMAPS));
+    EXPECT_EQ(num_pages - 1, get_counter(UCS_RCACHE_UNMAPS_MERGED));
+
+    /* the next operation processes the merged entry */
+    mem2 = alloc_pages(size1, PROT_READ|PROT_WRITE);
+    r1   = get(mem2, size1);
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_UNMAP_INVALIDATES));
+    EXPECT_EQ(1, get_counter(UCS_RCACHE_DEREGS));
+    EXPECT_TRUE(ucs_queue_is_empty(&m_rcache->inv_q));
+
+    put(r1);
+    munmap(mem2, size1);
+}
 #endif
 
 
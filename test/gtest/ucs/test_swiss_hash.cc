@@ -0,0 +1,193 @@
+/**
+* Copyright (c) NVIDIA CORPORATION & AFFILIATES, 2025. ALL RIGHTS RESERVED.
+*
+* See file LICENSE for terms.
+*/
+
+#include <common/test.h>
+extern "C" {
+#include <ucs/datastruct/swiss_hash.h>
+#include <ucs/datastruct/khash.h>
+#include <ucs/time/time.h>
+}
+
+#include <map>
+#include <vector>
+
+
+UCS_SWISS_HASH_TYPE(test_swiss, uint64_t, uint64_t)
+UCS_SWISS_HASH_IMPL(test_swiss, uint64_t, uint64_t, ucs_swiss_hash_int64_func,
+                    ucs_swiss_hash_int64_equal)
+
+KHASH_MAP_INIT_INT64(test_swiss_kh, uint64_t)
+
+
+class test_swiss_hash : public ucs::test {
+protected:
+    virtual void init()
+    {
+        ucs::test::init();
+        ucs_swiss_hash_init(test_swiss, &m_hash);
+    }
+
+    virtual void cleanup()
+    {
+        ucs_swiss_hash_destroy(test_swiss, &m_hash);
+        ucs::test::cleanup();
+    }
+
+    void put(uint64_t key, uint64_t value)
+    {
+        ucs_swiss_hash_iter_t iter;
+        int ret;
+
+        iter = ucs_swiss_hash_put(test_swiss, &m_hash, key, &ret);
+        ASSERT_EQ(UCS_SWISS_HASH_PUT_BUCKET_EMPTY, ret);
+        ucs_swiss_hash_value(&m_hash, iter) = value;
+    }
+
+    void check(const std::map<uint64_t, uint64_t> &ref)
+    {
+        std::map<uint64_t, uint64_t>::const_iterator it;
+        ucs_swiss_hash_iter_t iter;
+        size_t count = 0;
+
+        ASSERT_EQ(ref.size(), ucs_swiss_hash_size(&m_hash));
+        for (it = ref.begin(); it != ref.end(); ++it) {
+            iter = ucs_swiss_hash_get(test_swiss, &m_hash, it->first);
+            ASSERT_NE(ucs_swiss_hash_end(&m_hash), iter) << it->first;
+            EXPECT_EQ(it->second, ucs_swiss_hash_value(&m_hash, iter));
+        }
+
+        ucs_swiss_hash_for_each(&m_hash, iter) {
+            it = ref.find(ucs_swiss_hash_key(&m_hash, iter));
+            ASSERT_TRUE(it != ref.end());
+            EXPECT_EQ(it->second, ucs_swiss_hash_value(&m_hash, iter));
+            ++count;
+        }
+        EXPECT_EQ(ref.size(), count);
+    }
+
+    ucs_swiss_hash_t(test_swiss) m_hash;
+};
+
+UCS_TEST_F(test_swiss_hash, empty) {
+    ucs_swiss_hash_iter_t iter;
+    size_t count = 0;
+
+    EXPECT_EQ(ucs_swiss_hash_end(&m_hash),
+              ucs_swiss_hash_get(test_swiss, &m_hash, 0));
+    EXPECT_EQ(ucs_swiss_hash_end(&m_hash),
+              ucs_swiss_hash_get(test_swiss, &m_hash, 1234));
+
+    ucs_swiss_hash_for_each(&m_hash, iter) {
+        ++count;
+    }
+    EXPECT_EQ(0ul, count);
+}
+
+UCS_TEST_F(test_swiss_hash, put_get_del) {
+    const uint64_t count = 1000;
+    ucs_swiss_hash_iter_t iter;
+    uint64_t key;
+    int ret;
+
+    for (key = 0; key < count; ++key) {
+        put(key * 7, key);
+    }
+
+    iter = ucs_swiss_hash_put(test_swiss, &m_hash, 7, &ret);
+    EXPECT_EQ(UCS_SWISS_HASH_PUT_KEY_PRESENT, ret);
+    EXPECT_EQ(1ul, ucs_swiss_hash_value(&m_hash, iter));
+
+    for (key = 0; key < count; ++key) {
+        iter = ucs_swiss_hash_get(test_swiss, &m_hash, key * 7);
+        ASSERT_NE(ucs_swiss_hash_end(&m_hash), iter);
+        EXPECT_EQ(key, ucs_swiss_hash_value(&m_hash, iter));
+        EXPECT_EQ(ucs_swiss_hash_end(&m_hash),
+                  ucs_swiss_hash_get(test_swiss, &m_hash, key * 7 + 1));
+    }
+
+    for (key = 0; key < count; key += 2) {
+        iter = ucs_swiss_hash_get(test_swiss, &m_hash, key * 7);
+        ucs_swiss_hash_del(test_swiss, &m_hash, iter);
+    }
+
+    EXPECT_EQ(count / 2, ucs_swiss_hash_size(&m_hash));
+    for (key = 0; key < count; ++key) {
+        iter = ucs_swiss_hash_get(test_swiss, &m_hash, key * 7);
+        EXPECT_EQ((key % 2) == 0, ucs_swiss_hash_end(&m_hash) == iter);
+    }
+}
+
+UCS_TEST_F(test_swiss_hash, random_ops) {
+    const int num_ops = 100000 / ucs::test_time_multiplier();
+    std::map<uint64_t, uint64_t> ref;
+    ucs_swiss_hash_iter_t iter;
+    uint64_t key;
+    int i;
+
+    /* Keys in a small range, so there are many deletions and re-insertions,
+     * which create tombstones */
+    for (i = 0; i < num_ops; ++i) {
+        key  = ucs::rand() % 2048;
+        iter = ucs_swiss_hash_get(test_swiss, &m_hash, key);
+        if (ref.find(key) == ref.end()) {
+            ASSERT_EQ(ucs_swiss_hash_end(&m_hash), iter);
+            put(key, i);
+            ref[key] = i;
+        } else {
+            ASSERT_NE(ucs_swiss_hash_end(&m_hash), iter);
+            ASSERT_EQ(ref[key], ucs_swiss_hash_value(&m_hash, iter));
+            ucs_swiss_hash_del(test_swiss, &m_hash, iter);
+            ref.erase(key);
+        }
+    }
+
+    check(ref);
+}
+
+UCS_TEST_SKIP_COND_F(test_swiss_hash, lookup_perf,
+                     (ucs::test_time_multiplier() > 1)) {
+    const size_t num_keys    = 4096;
+    const size_t num_lookups = 10000000;
+    khash_t(test_swiss_kh) kh = KHASH_STATIC_INITIALIZER;
+    std::vector<uint64_t> keys(num_keys);
+    ucs_time_t start_time, kh_time, swiss_time;
+    uint64_t sum_kh = 0, sum_swiss = 0;
+    ucs_swiss_hash_iter_t iter;
+    khiter_t khiter;
+    size_t i;
+    int ret;
+
+    for (i = 0; i < num_keys; ++i) {
+        keys[i] = ((uint64_t)ucs::rand() << 32) | ucs::rand();
+        put(keys[i], i);
+        khiter = kh_put(test_swiss_kh, &kh, keys[i], &ret);
+        ASSERT_NE(UCS_KH_PUT_FAILED, ret);
+        kh_value(&kh, khiter) = i;
+    }
+
+    start_time = ucs_get_time();
+    for (i = 0; i < num_lookups; ++i) {
+        khiter  = kh_get(test_swiss_kh, &kh, keys[(i * 7) % num_keys]);
+        sum_kh += kh_value(&kh, khiter);
+    }
+    kh_time = ucs_get_time() - start_time;
+
+    start_time = ucs_get_time();
+    for (i = 0; i < num_lookups; ++i) {
+        iter       = ucs_swiss_hash_get(test_swiss, &m_hash,
+                                        keys[(i * 7) % num_keys]);
+        sum_swiss += ucs_swiss_hash_value(&m_hash, iter);
+    }
+    swiss_time = ucs_get_time() - start_time;
+
+    kh_destroy_inplace(test_swiss_kh, &kh);
+
+    EXPECT_EQ(sum_kh, sum_swiss);
+    UCS_TEST_MESSAGE << "khash: " << ucs_time_to_nsec(kh_time) / num_lookups
+                     << " nsec, swiss_hash: "
+                     << ucs_time_to_nsec(swiss_time) / num_lookups
+                     << " nsec per lookup";
+}
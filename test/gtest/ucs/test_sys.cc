@@ -16,6 +16,7 @@ extern "C" {
 
 #include <sys/mman.h>
 #include <set>
+#include <vector>
 
 class test_sys : public ucs::test {
 protected:
@@ -98,6 +99,88 @@ UCS_TEST_F(test_sys, get_mem_prot) {
     UCS_TEST_MESSAGE << "Time: " << ucs_time_to_usec(duration) << " us";
 }
 
+class test_sys_vma : public test_sys {
+protected:
+    static const char *methods[];
+
+    static void *map_pages(size_t count, int prot)
+    {
+        void *ptr = mmap(NULL, count * ucs_get_page_size(), prot,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        EXPECT_NE(MAP_FAILED, ptr) << strerror(errno);
+        return ptr;
+    }
+};
+
+const char *test_sys_vma::methods[] = {"ioctl", "cache", "parse", "auto"};
+
+UCS_TEST_F(test_sys_vma, get_mem_prot) {
+    const size_t page_size = ucs_get_page_size();
+
+    for (size_t i = 0; i < ucs_static_array_size(methods); ++i) {
+        UCS_TEST_MESSAGE << methods[i];
+        modify_config("VMA_QUERY", methods[i]);
+
+        /* Middle page has a different protection */
+        char *ptr = (char*)map_pages(3, PROT_READ | PROT_WRITE);
+        ASSERT_EQ(0, mprotect(ptr + page_size, page_size, PROT_READ));
+
+        EXPECT_EQ(PROT_READ | PROT_WRITE, get_mem_prot(ptr, page_size));
+        EXPECT_EQ(PROT_READ, get_mem_prot(ptr + page_size, page_size));
+        EXPECT_EQ(PROT_READ, get_mem_prot(ptr, 3 * page_size));
+        EXPECT_EQ(PROT_READ | PROT_WRITE,
+                  get_mem_prot(ptr + 2 * page_size, page_size));
+
+        /* Unmapped memory is detected after the table was used */
+        munmap(ptr, 3 * page_size);
+        EXPECT_EQ(PROT_NONE, get_mem_prot(ptr, page_size));
+        EXPECT_EQ(PROT_NONE, get_mem_prot(ptr + page_size, 2 * page_size));
+
+        /* New mapping is detected as well */
+        ptr = (char*)map_pages(1, PROT_READ);
+        EXPECT_EQ(PROT_READ, get_mem_prot(ptr, page_size));
+        munmap(ptr, page_size);
+    }
+}
+
+UCS_TEST_SKIP_COND_F(test_sys_vma, get_mem_prot_perf,
+                     (ucs::test_time_multiplier() > 1)) {
+    const size_t num_maps  = 10000;
+    const size_t page_size = ucs_get_page_size();
+    std::vector<char*> maps;
+    ucs_time_t start_time;
+    size_t num_lookups, j;
+    int prot;
+
+    /* Alternate protection, so adjacent mappings are not merged */
+    for (size_t i = 0; i < num_maps; ++i) {
+        prot = (i % 2) ? PROT_READ : (PROT_READ | PROT_WRITE);
+        maps.push_back((char*)map_pages(1, prot));
+    }
+
+    for (size_t i = 0; i < ucs_static_array_size(methods); ++i) {
+        modify_config("VMA_QUERY", methods[i]);
+
+        num_lookups = strcmp(methods[i], "parse") ? 100000 : 100;
+        start_time  = ucs_get_time();
+        for (j = 0; j < num_lookups; ++j) {
+            /* Every lookup goes to a different mapping */
+            prot = get_mem_prot(maps[(j * 7919) % num_maps], page_size);
+            ASSERT_TRUE(prot & PROT_READ);
+        }
+
+        UCS_TEST_MESSAGE << methods[i] << ": "
+                         << ucs_time_to_nsec(ucs_get_time() - start_time) /
+                            num_lookups
+                         << " nsec per lookup with " << num_maps
+                         << " mappings";
+    }
+
+    for (j = 0; j < num_maps; ++j) {
+        munmap(maps[j], page_size);
+    }
+}
+
 UCS_TEST_F(test_sys, fcntl) {
     ucs_status_t status;
     int fd, fl;
@@ -9,8 +9,11 @@ extern "C" {
 #include <ucs/memory/numa.h>
 #include <ucs/sys/sys.h>
 #include <ucs/sys/topo/base/topo.h>
+#include <ucs/time/time.h>
 }
 
+#include <dirent.h>
+
 class test_topo : public ucs::test {
 };
 
@@ -151,3 +154,63 @@ UCS_TEST_F(test_topo, numa_distance) {
         }
     }
 }
+
+UCS_TEST_SKIP_COND_F(test_topo, distance_perf,
+                     (ucs::test_time_multiplier() > 1)) {
+    static const unsigned max_devices = 32;
+    static const unsigned iters       = 1000;
+    std::vector<ucs_sys_device_t> devices;
+    unsigned num_nodes = ucs_numa_num_configured_nodes();
+    ucs_sys_dev_distance_t distance;
+    ucs_numa_distance_t numa_distance = 0;
+    ucs_sys_device_t sys_dev;
+    ucs_time_t start_time;
+    struct dirent *entry;
+    double elapsed;
+    DIR *dir;
+
+    /* Register the devices found in the system, like transports do */
+    dir = opendir("/sys/bus/pci/devices");
+    if (dir != NULL) {
+        while (((entry = readdir(dir)) != NULL) &&
+               (devices.size() < max_devices)) {
+            if ((entry->d_name[0] != '.') &&
+                (ucs_topo_find_device_by_bdf_name(entry->d_name, &sys_dev) ==
+                 UCS_OK)) {
+                devices.push_back(sys_dev);
+            }
+        }
+        closedir(dir);
+    }
+
+    if (devices.size() < 2) {
+        UCS_TEST_SKIP_R("not enough PCI devices");
+    }
+
+    start_time = ucs_get_time();
+    for (unsigned i = 0; i < iters; ++i) {
+        for (auto dev1 : devices) {
+            for (auto dev2 : devices) {
+                ASSERT_UCS_OK(ucs_topo_get_distance(dev1, dev2, &distance));
+            }
+        }
+    }
+    elapsed = ucs_time_to_nsec(ucs_get_time() - start_time);
+    UCS_TEST_MESSAGE << devices.size() << " devices: "
+                     << elapsed / (iters * devices.size() * devices.size())
+                     << " nsec per device distance";
+
+    start_time = ucs_get_time();
+    for (unsigned i = 0; i < iters; ++i) {
+        for (ucs_numa_node_t node1 = 0; node1 < num_nodes; ++node1) {
+            for (ucs_numa_node_t node2 = 0; node2 < num_nodes; ++node2) {
+                numa_distance += ucs_numa_distance(node1, node2);
+            }
+        }
+    }
+    elapsed = ucs_time_to_nsec(ucs_get_time() - start_time);
+    UCS_TEST_MESSAGE << num_nodes << " NUMA nodes: "
+                     << elapsed / (iters * num_nodes * num_nodes)
+                     << " nsec per node distance";
+    EXPECT_GE(numa_distance, iters * num_nodes * num_nodes * 10);
+}
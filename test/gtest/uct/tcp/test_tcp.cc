@@ -13,6 +13,11 @@ extern "C" {
 
 class test_uct_tcp : public uct_test {
 public:
+    test_uct_tcp() : m_tcp_iface(NULL), m_ent(NULL), m_am_count(0),
+                     m_am_length(0), m_am_flags(0)
+    {
+    }
+
     void init() {
         if (RUNNING_ON_VALGRIND) {
             modify_config("TCP_TX_SEG_SIZE", "1kb");
@@ -41,6 +46,20 @@ public:
         return num;
     }
 
+    size_t get_partial_hdr_conn_num(size_t length) {
+        size_t num = 0;
+        uct_tcp_ep_t *ep;
+
+        UCS_ASYNC_BLOCK(m_tcp_iface->super.worker->async);
+        ucs_list_for_each(ep, &m_tcp_iface->ep_list, list) {
+            num += (ep->conn_state == UCT_TCP_EP_CONN_STATE_ACCEPTING) &&
+                   (ep->rx.length == length);
+        }
+        UCS_ASYNC_UNBLOCK(m_tcp_iface->super.worker->async);
+
+        return num;
+    }
+
     ucs_status_t post_recv(int fd, bool nb = false) {
         uint8_t msg;
         size_t msg_size = sizeof(msg);
@@ -156,6 +175,44 @@ public:
         }
     }
 
+    size_t get_am_rx_into_conn_num() {
+        size_t num = 0;
+        uct_tcp_ep_t *ep;
+
+        UCS_ASYNC_BLOCK(m_tcp_iface->super.worker->async);
+        ucs_list_for_each(ep, &m_tcp_iface->ep_list, list) {
+            if (ep->flags & UCT_TCP_EP_FLAG_AM_RX_INTO) {
+                // EP must not hold the shared RX buffer while the payload is
+                // received to the user's buffer
+                EXPECT_EQ(&m_tcp_iface->rx_hdr_mpool,
+                          ucs_mpool_obj_owner(ep->rx.buf));
+                ++num;
+            }
+        }
+        UCS_ASYNC_UNBLOCK(m_tcp_iface->super.worker->async);
+
+        return num;
+    }
+
+    static void *am_recv_into_cb(void *arg, const void *data, size_t length) {
+        test_uct_tcp *self = reinterpret_cast<test_uct_tcp*>(arg);
+
+        EXPECT_EQ(AM_HDR, *reinterpret_cast<const uint64_t*>(data));
+        EXPECT_EQ(sizeof(uint64_t) + self->m_recv_buf.size(), length);
+        return &self->m_recv_buf[0];
+    }
+
+    static ucs_status_t am_cb(void *arg, void *data, size_t length,
+                              unsigned flags) {
+        test_uct_tcp *self = reinterpret_cast<test_uct_tcp*>(arg);
+
+        EXPECT_EQ(AM_HDR, *reinterpret_cast<const uint64_t*>(data));
+        self->m_am_length = length;
+        self->m_am_flags  = flags;
+        ++self->m_am_count;
+        return UCS_OK;
+    }
+
 private:
     void init_data(void *buf, size_t msg_size) {
         uct_tcp_am_hdr_t *tcp_am_hdr;
@@ -185,7 +242,8 @@ private:
 
         int fd;
         EXPECT_TRUE((dest_addr.ss_family == AF_INET) ||
-                    (dest_addr.ss_family == AF_INET6));
+                    (dest_addr.ss_family == AF_INET6) ||
+                    (dest_addr.ss_family == AF_UNIX));
         status = ucs_socket_create(dest_addr.ss_family, SOCK_STREAM, &fd);
         ASSERT_UCS_OK(status);
 
@@ -231,10 +289,19 @@ private:
     }
 
 protected:
-    uct_tcp_iface *m_tcp_iface;
-    entity        *m_ent;
+    static const uint8_t  AM_ID  = 1;
+    static const uint64_t AM_HDR;
+
+    uct_tcp_iface     *m_tcp_iface;
+    entity            *m_ent;
+    std::vector<char> m_recv_buf;
+    unsigned          m_am_count;
+    size_t            m_am_length;
+    unsigned          m_am_flags;
 };
 
+const uint64_t test_uct_tcp::AM_HDR = 0xdeadbeefull;
+
 UCS_TEST_P(test_uct_tcp, listener_flood_connect_and_send_large) {
     const size_t max_conn =
         ucs_min(static_cast<size_t>(max_connections()), 128lu) /
@@ -259,6 +326,108 @@ UCS_TEST_P(test_uct_tcp, listener_flood_connect_and_close) {
     test_listener_flood(*m_ent, max_conn, 0);
 }
 
+UCS_TEST_P(test_uct_tcp, rx_buf_partial_hdr) {
+    const size_t max_conn =
+        ucs_min(static_cast<size_t>(max_connections()), 128lu) /
+        ucs::test_time_multiplier();
+    const size_t hdr_length = sizeof(uct_tcp_am_hdr_t) - 1;
+    uint64_t magic_number   = UCT_TCP_MAGIC_NUMBER;
+    std::vector<char> buf(sizeof(magic_number) + hdr_length, 0);
+    std::vector<int> fds;
+    uct_tcp_ep_t *ep;
+
+    memcpy(&buf[0], &magic_number, sizeof(magic_number));
+    setup_conns_to_entity(*m_ent, max_conn, fds);
+    for (size_t i = 0; i < fds.size(); ++i) {
+        post_send(fds[i], buf);
+    }
+
+    while (get_partial_hdr_conn_num(hdr_length) != max_conn) {
+        sched_yield();
+        progress();
+    }
+
+    // EPs with a partially received header must not hold the shared RX
+    // buffer or a full-size RX buffer
+    UCS_ASYNC_BLOCK(m_tcp_iface->super.worker->async);
+    ucs_list_for_each(ep, &m_tcp_iface->ep_list, list) {
+        ASSERT_TRUE(ep->rx.buf != NULL);
+        EXPECT_NE(m_tcp_iface->rx_buf, ep->rx.buf);
+        EXPECT_EQ(&m_tcp_iface->rx_hdr_mpool, ucs_mpool_obj_owner(ep->rx.buf));
+    }
+    UCS_ASYNC_UNBLOCK(m_tcp_iface->super.worker->async);
+
+    while (!fds.empty()) {
+        close(fds.back());
+        fds.pop_back();
+    }
+
+    while (!ucs_list_is_empty(&m_tcp_iface->ep_list)) {
+        sched_yield();
+        progress();
+    }
+}
+
+UCS_TEST_P(test_uct_tcp, am_rx_into) {
+    const size_t payload_length = m_tcp_iface->config.rx_seg_size / 2;
+    uint64_t magic_number       = UCT_TCP_MAGIC_NUMBER;
+    uint64_t am_hdr             = AM_HDR;
+    std::vector<char> payload(payload_length);
+    std::vector<char> buf;
+    uct_tcp_am_hdr_t hdr;
+    std::vector<int> fds;
+    ucs_status_t status;
+
+    status = uct_iface_set_am_handler(m_ent->iface(), AM_ID, am_cb, this, 0);
+    ASSERT_UCS_OK(status);
+    status = uct_iface_set_am_recv_into_handler(m_ent->iface(), AM_ID,
+                                                am_recv_into_cb, this,
+                                                sizeof(am_hdr));
+    ASSERT_UCS_OK(status);
+
+    ucs::fill_random(payload);
+    m_recv_buf.resize(payload_length, 0);
+
+    hdr.am_id  = AM_ID;
+    hdr.length = sizeof(am_hdr) + payload_length;
+    buf.insert(buf.end(), reinterpret_cast<char*>(&magic_number),
+               reinterpret_cast<char*>(&magic_number + 1));
+    buf.insert(buf.end(), reinterpret_cast<char*>(&hdr),
+               reinterpret_cast<char*>(&hdr + 1));
+    buf.insert(buf.end(), reinterpret_cast<char*>(&am_hdr),
+               reinterpret_cast<char*>(&am_hdr + 1));
+    buf.insert(buf.end(), payload.begin(), payload.begin() + 1);
+
+    setup_conns_to_entity(*m_ent, 1, fds);
+    post_send(fds[0], buf);
+
+    // The rest of the payload has to be received to the user's buffer
+    while (get_am_rx_into_conn_num() != 1) {
+        sched_yield();
+        progress();
+    }
+
+    buf.assign(payload.begin() + 1, payload.end());
+    post_send(fds[0], buf);
+
+    while (m_am_count == 0) {
+        sched_yield();
+        progress();
+    }
+
+    EXPECT_EQ(1u, m_am_count);
+    EXPECT_EQ(sizeof(am_hdr) + payload_length, m_am_length);
+    EXPECT_TRUE(m_am_flags & UCT_CB_PARAM_FLAG_RECV_INTO);
+    EXPECT_EQ(payload, m_recv_buf);
+    EXPECT_EQ(0u, get_am_rx_into_conn_num());
+
+    close(fds[0]);
+    while (!ucs_list_is_empty(&m_tcp_iface->ep_list)) {
+        sched_yield();
+        progress();
+    }
+}
+
 UCS_TEST_P(test_uct_tcp, check_addr_len)
 {
     uct_iface_attr_t iface_attr;
@@ -267,7 +436,8 @@ UCS_TEST_P(test_uct_tcp, check_addr_len)
     ASSERT_UCS_OK(status);
 
     UCS_TEST_MESSAGE << m_ent->md()->component->name;
-    if (!GetParam()->dev_name.compare("lo")) {
+    if (!GetParam()->dev_name.compare("lo") ||
+        !GetParam()->dev_name.compare(UCT_TCP_UNIX_DEV_NAME)) {
         EXPECT_EQ(sizeof(uct_tcp_device_addr_t) +
                           sizeof(uct_iface_local_addr_ns_t),
                   iface_attr.device_addr_len);
@@ -288,3 +458,79 @@ UCS_TEST_P(test_uct_tcp, check_addr_len)
 
 
 _UCT_INSTANTIATE_TEST_CASE(test_uct_tcp, tcp)
+
+
+class test_uct_tcp_busy_poll : public test_uct_tcp {
+public:
+    void init() {
+        modify_config("TCP_BUSY_POLL", "50us");
+        modify_config("TCP_BUSY_POLL_IDLE", "1ms");
+        test_uct_tcp::init();
+
+        if (m_tcp_iface->config.busy_poll.usec == 0) {
+            UCS_TEST_SKIP_R("epoll busy polling is not supported");
+        }
+    }
+
+    void wait_busy_poll_state(int active) {
+        ucs_time_t deadline = ucs_get_time() +
+                              ucs_time_from_sec(DEFAULT_TIMEOUT_SEC);
+
+        while ((m_tcp_iface->busy_poll.active != active) &&
+               (ucs_get_time() < deadline)) {
+            sched_yield();
+            progress();
+        }
+
+        EXPECT_EQ(active, m_tcp_iface->busy_poll.active);
+    }
+};
+
+UCS_TEST_P(test_uct_tcp_busy_poll, switch_to_interrupt_mode) {
+    uint64_t magic_number = UCT_TCP_MAGIC_NUMBER;
+    uint64_t am_hdr       = AM_HDR;
+    std::vector<char> buf;
+    uct_tcp_am_hdr_t hdr;
+    std::vector<int> fds;
+    ucs_status_t status;
+
+    status = uct_iface_set_am_handler(m_ent->iface(), AM_ID, am_cb, this, 0);
+    ASSERT_UCS_OK(status);
+
+    EXPECT_EQ(50, m_tcp_iface->sockopt.busy_poll);
+
+    // Busy polling is disabled when the interface becomes idle
+    wait_busy_poll_state(0);
+
+    hdr.am_id  = AM_ID;
+    hdr.length = sizeof(am_hdr);
+    buf.insert(buf.end(), reinterpret_cast<char*>(&magic_number),
+               reinterpret_cast<char*>(&magic_number + 1));
+    buf.insert(buf.end(), reinterpret_cast<char*>(&hdr),
+               reinterpret_cast<char*>(&hdr + 1));
+    buf.insert(buf.end(), reinterpret_cast<char*>(&am_hdr),
+               reinterpret_cast<char*>(&am_hdr + 1));
+
+    setup_conns_to_entity(*m_ent, 1, fds);
+    post_send(fds[0], buf);
+
+    while (m_am_count == 0) {
+        sched_yield();
+        progress();
+    }
+
+    // Busy polling is enabled again after receiving events
+    EXPECT_EQ(1, m_tcp_iface->busy_poll.active);
+    EXPECT_EQ(1u, m_am_count);
+    EXPECT_EQ(sizeof(am_hdr), m_am_length);
+
+    wait_busy_poll_state(0);
+
+    close(fds[0]);
+    while (!ucs_list_is_empty(&m_tcp_iface->ep_list)) {
+        sched_yield();
+        progress();
+    }
+}
+
+_UCT_INSTANTIATE_TEST_CASE(test_uct_tcp_busy_poll, tcp)